@@ -0,0 +1,100 @@
+// Runs the same workload against every storage backend and prints the
+// average time per operation, to help pick a backend for a product.
+//
+// write: store KEYS values of VALUE_LENGTH bytes
+// read:  read them back
+// boot:  remount (or reopen) the backend and read every key, like the
+//        parameter definitions in setup() do after a reboot
+//
+// WARNING: SPIFFS.begin(true) formats the default "spiffs" partition if it
+// does not hold a SPIFFS filesystem, e.g. because your application uses
+// LittleFS on it. Flash this only to a board whose data you can lose.
+// LittleFS is benchmarked on its own partition labelled "littlefs", so the
+// two filesystems never reformat each other; add one to your partition
+// table to include it.
+
+#include <LittleFS.h>
+#include <SPIFFS.h>
+#include <FSStorage.h>
+#include <NVSStorage.h>
+#include <HeadlessWiFiSettingsStorage.h>
+
+const int KEYS = 20;
+const int VALUE_LENGTH = 32;
+const int ROUNDS = 5;
+#define LITTLEFS_PARTITION "littlefs"
+
+String key(int i) { return "bench_param_" + String(i); }
+
+void report(const char* name, unsigned long write_us, unsigned long read_us, unsigned long boot_us) {
+    Serial.printf("%-10s %10lu %10lu %10lu\n", name,
+                  write_us / (ROUNDS * KEYS), read_us / (ROUNDS * KEYS), boot_us / ROUNDS);
+}
+
+// remount() must make the backend forget anything it cached in RAM.
+void bench(const char* name, HeadlessWiFiSettingsStorage& storage, std::function<void()> remount) {
+    String value;
+    for (int i = 0; i < VALUE_LENGTH; i++) value += (char)('a' + i % 26);
+
+    unsigned long write_us = 0, read_us = 0, boot_us = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        value[0] = (char)('A' + round);  // make sure every round really writes
+
+        unsigned long start = micros();
+        for (int i = 0; i < KEYS; i++) {
+            if (!storage.write(key(i), value)) Serial.printf("%s: write failed\n", name);
+        }
+        write_us += micros() - start;
+
+        start = micros();
+        for (int i = 0; i < KEYS; i++) {
+            if (storage.read(key(i)) != value) Serial.printf("%s: read mismatch\n", name);
+        }
+        read_us += micros() - start;
+
+        start = micros();
+        remount();
+        for (int i = 0; i < KEYS; i++) storage.read(key(i));
+        boot_us += micros() - start;
+    }
+
+    for (int i = 0; i < KEYS; i++) storage.write(key(i), "");
+    report(name, write_us, read_us, boot_us);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.printf("%d keys of %d bytes, %d rounds\n", KEYS, VALUE_LENGTH, ROUNDS);
+    Serial.printf("%-10s %10s %10s %10s\n", "backend", "write us", "read us", "boot us");
+
+    MemoryStorage memory;
+    bench("memory", memory, []() {});
+
+    if (SPIFFS.begin(true)) {
+        FSStorage spiffs(SPIFFS);
+        bench("spiffs", spiffs, []() { SPIFFS.end(); SPIFFS.begin(); });
+        SPIFFS.end();
+    } else {
+        Serial.println("spiffs: mount failed");
+    }
+
+    if (LittleFS.begin(true, "/littlefs", 10, LITTLEFS_PARTITION)) {
+        FSStorage littlefs(LittleFS, "/bench/", true);
+        LittleFS.mkdir("/bench");
+        bench("littlefs", littlefs, []() { LittleFS.end(); LittleFS.begin(false, "/littlefs", 10, LITTLEFS_PARTITION); });
+        LittleFS.rmdir("/bench");
+        LittleFS.end();
+    } else {
+        Serial.println("littlefs: no \"" LITTLEFS_PARTITION "\" partition, skipped");
+    }
+
+    NVSStorage nvs("hws-bench");
+    bench("nvs", nvs, [&nvs]() { nvs.end(); });
+    nvs.end();
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,308 @@
+#!/usr/bin/env python3
+"""Concurrent load generator for the HeadlessWiFiSettings HTTP routes.
+
+Drives a mix of GET /wifi/<endpoint>, POST /wifi/<endpoint> and GET /wifi/scan
+from several threads and reports throughput, latency percentiles, status codes
+and, against the host build, the number of flash writes. It also checks that
+every value read back is one that was actually written, to catch torn or
+lost updates. Every accepted POST must show up in GET /wifi/changes since the
+generation before it; that check is skipped when the limiter turns the extra
+GET away. Against the host build, whose scan results never change, every
+scan must list exactly the networks of a first scan made before the load, and
+the WiFi stand-in must not report scan results used after they were freed.
+
+Run the host build first (see README), then:
+
+    python3 load_test.py --concurrency 16 --duration 10
+    python3 load_test.py --mix get=50,post=50,scan=0 http://192.168.4.1
+
+Exits non-zero if any request failed or returned unexpected data.
+"""
+import argparse
+import http.client
+import json
+import random
+import string
+import sys
+import threading
+import time
+from collections import Counter, defaultdict
+from urllib.parse import urlencode, urlparse
+
+# Parameters defined by examples/Test/Test.ino, with generators for new values.
+# The string generators never repeat a value, so every POST changes those.
+ENDPOINTS = {
+    "main": {
+        "test_string": lambda: "s-" + "".join(random.choices(string.ascii_letters, k=8)),
+        "test_int": lambda: str(random.randint(0, 100)),
+        "test_bool": lambda: random.choice(["1", ""]),
+    },
+    "extras": {
+        "test_float": lambda: "%.2f" % random.uniform(0, 10),
+        "test_extra": lambda: "e-" + "".join(random.choices(string.ascii_letters, k=8)),
+    },
+}
+ALWAYS_CHANGED = {"test_string", "test_extra"}
+
+
+def normalize(value):
+    if isinstance(value, bool):
+        return value
+    if isinstance(value, (int, float)):
+        return round(float(value), 2)
+    return value
+
+
+def posted_as_json(name, raw):
+    """What a posted form value reads back as."""
+    if name == "test_bool":
+        return bool(raw)
+    if name in ("test_int", "test_float"):
+        return round(float(raw), 2)
+    return raw
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.latencies = defaultdict(list)
+        self.statuses = defaultdict(Counter)
+        self.errors = []
+        self.error_count = 0
+        # Every value each key may legitimately have; starts with what was
+        # there before the run.
+        self.written = defaultdict(set)
+        # Networks every scan must list, or None if they may change.
+        self.scan_baseline = None
+        self.epoch = None
+        self.changes_checked = 0
+
+    def record(self, kind, status, seconds):
+        with self.lock:
+            self.latencies[kind].append(seconds)
+            self.statuses[kind][status] += 1
+
+    def error(self, message):
+        with self.lock:
+            self.error_count += 1
+            if len(self.errors) < 20:
+                self.errors.append(message)
+
+
+def request(base, method, path, body=None):
+    conn = http.client.HTTPConnection(base.hostname, base.port or 80, timeout=30)
+    headers = {}
+    if body is not None:
+        body = urlencode(body)
+        headers["Content-Type"] = "application/x-www-form-urlencoded"
+    conn.request(method, path, body=body, headers=headers)
+    response = conn.getresponse()
+    data = response.read()
+    conn.close()
+    return response.status, data
+
+
+def check_get(stats, endpoint, data):
+    doc = json.loads(data)
+    if set(doc) != {"values", "defaults"}:
+        raise ValueError("unexpected keys %s" % sorted(doc))
+    for name, value in doc["values"].items():
+        with stats.lock:
+            allowed = stats.written[name]
+            if normalize(value) not in allowed:
+                raise ValueError("%s=%r was never written" % (name, value))
+
+
+def get_changes(base, stats, since):
+    """GET /wifi/changes in the epoch of the run; None if turned away."""
+    path = "/wifi/changes?" + urlencode({"epoch": stats.epoch, "since": since})
+    start = time.monotonic()
+    status, data = request(base, "GET", path)
+    stats.record("changes", status, time.monotonic() - start)
+    if status in (429, 503):
+        return None
+    if status != 200:
+        raise ValueError("status %d" % status)
+    doc = json.loads(data)
+    if doc.get("epoch") != stats.epoch or doc.get("reset"):
+        raise ValueError("epoch %r, reset %r" % (doc.get("epoch"), doc.get("reset")))
+    return doc
+
+
+def check_changes(base, stats, endpoint, body, since):
+    """An accepted POST must be listed by /wifi/changes?since=<generation before it>."""
+    doc = get_changes(base, stats, since)
+    if doc is None:
+        return
+    if doc["generation"] <= since:
+        raise ValueError("generation %d, expected more than %d" % (doc["generation"], since))
+    listed = doc["changes"].get(endpoint, {})
+    for name in ALWAYS_CHANGED & set(body):
+        if name not in listed:
+            raise ValueError("%s missing since %d: %r" % (name, since, doc["changes"]))
+        with stats.lock:
+            if normalize(listed[name]) not in stats.written[name]:
+                raise ValueError("%s=%r was never written" % (name, listed[name]))
+    with stats.lock:
+        stats.changes_checked += 1
+
+
+def check_scan(stats, data):
+    doc = json.loads(data)
+    networks = doc.get("networks")
+    if not isinstance(networks, dict):
+        raise ValueError("no networks object")
+    if stats.scan_baseline is not None and networks != stats.scan_baseline:
+        raise ValueError("networks %r, expected %r" % (networks, stats.scan_baseline))
+
+
+def worker(base, mix, deadline, stats):
+    kinds, weights = zip(*mix.items())
+    while time.monotonic() < deadline:
+        kind = random.choices(kinds, weights)[0]
+        endpoint = random.choice(list(ENDPOINTS))
+        body = None
+        if kind == "post":
+            body = {name: gen() for name, gen in ENDPOINTS[endpoint].items()}
+            # Register before sending, so a concurrent reader may see it.
+            with stats.lock:
+                for name, raw in body.items():
+                    stats.written[name].add(posted_as_json(name, raw))
+        path = "/wifi/scan" if kind == "scan" else "/wifi/" + endpoint
+
+        since = None
+        if kind == "post":
+            try:
+                doc = get_changes(base, stats, 0xFFFFFFFF)
+                since = doc and doc["generation"]
+            except Exception as e:
+                stats.error("changes before POST %s: %s" % (path, e))
+
+        start = time.monotonic()
+        try:
+            status, data = request(base, "POST" if body else "GET", path, body)
+        except Exception as e:  # connection reset, timeout, ...
+            stats.record(kind, "error", time.monotonic() - start)
+            stats.error("%s %s: %s" % (kind, path, e))
+            continue
+        stats.record(kind, status, time.monotonic() - start)
+
+        if status in (429, 503):
+            continue
+        try:
+            if status != 200:
+                raise ValueError("status %d" % status)
+            if kind == "get":
+                check_get(stats, endpoint, data)
+            elif kind == "scan":
+                check_scan(stats, data)
+        except ValueError as e:
+            stats.error("%s %s: %s" % (kind, path, e))
+            continue
+        if since is not None:
+            try:
+                check_changes(base, stats, endpoint, body, since)
+            except Exception as e:
+                stats.error("changes after POST %s: %s" % (path, e))
+
+
+def host_stats(base):
+    try:
+        status, data = request(base, "GET", "/host/stats")
+        return json.loads(data) if status == 200 else None
+    except Exception:
+        return None
+
+
+def percentile(values, p):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("url", nargs="?", default="http://127.0.0.1:8080")
+    parser.add_argument("--concurrency", type=int, default=8)
+    parser.add_argument("--duration", type=float, default=10, help="seconds")
+    parser.add_argument("--mix", default="get=70,post=20,scan=10", help="relative weights")
+    args = parser.parse_args()
+
+    base = urlparse(args.url)
+    mix = {k: float(v) for k, v in (part.split("=") for part in args.mix.split(","))}
+    mix = {k: v for k, v in mix.items() if v > 0}
+    if not mix or set(mix) - {"get", "post", "scan"}:
+        parser.error("--mix takes get, post and scan weights")
+
+    stats = Stats()
+    before = host_stats(base)
+    for endpoint in ENDPOINTS:
+        status, data = request(base, "GET", "/wifi/" + endpoint)
+        if status != 200:
+            sys.exit("GET /wifi/%s returned %d; is the Test example running?" % (endpoint, status))
+        for name, value in json.loads(data)["values"].items():
+            stats.written[name].add(normalize(value))
+
+    # Without an epoch the device lists every parameter and tells us its epoch.
+    status, data = request(base, "GET", "/wifi/changes")
+    if status != 200:
+        sys.exit("GET /wifi/changes returned %d" % status)
+    doc = json.loads(data)
+    if not doc.get("reset"):
+        sys.exit("GET /wifi/changes without epoch is not a reset")
+    for endpoint, names in ENDPOINTS.items():
+        missing = set(names) - set(doc["changes"].get(endpoint, {}))
+        if missing:
+            sys.exit("GET /wifi/changes without epoch did not list %s" % sorted(missing))
+    stats.epoch = doc["epoch"]
+    if before and mix.get("scan"):
+        status, data = request(base, "GET", "/wifi/scan")
+        if status != 200:
+            sys.exit("GET /wifi/scan returned %d" % status)
+        stats.scan_baseline = json.loads(data)["networks"]
+
+    deadline = time.monotonic() + args.duration
+    threads = [threading.Thread(target=worker, args=(base, mix, deadline, stats)) for _ in range(args.concurrency)]
+    start = time.monotonic()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = time.monotonic() - start
+    after = host_stats(base)
+
+    total = sum(len(v) for v in stats.latencies.values())
+    print("%d requests in %.1f s with %d clients: %.1f req/s" % (total, elapsed, args.concurrency, total / elapsed))
+    print()
+    print("%-6s %8s %9s %9s %9s  %s" % ("route", "count", "p50 ms", "p99 ms", "max ms", "status codes"))
+    for kind in sorted(stats.latencies):
+        lat = stats.latencies[kind]
+        codes = " ".join("%s:%d" % (code, n) for code, n in sorted(stats.statuses[kind].items(), key=str))
+        print("%-6s %8d %9.1f %9.1f %9.1f  %s" % (kind, len(lat), percentile(lat, 50) * 1000,
+                                               percentile(lat, 99) * 1000, max(lat) * 1000, codes))
+
+    if stats.statuses["post"][200]:
+        print()
+        print("changes: %d of %d accepted POSTs checked" % (stats.changes_checked, stats.statuses["post"][200]))
+
+    if before and after:
+        posts = stats.statuses["post"][200]
+        writes = after["flash_writes"] - before["flash_writes"]
+        print()
+        print("flash writes: %d (%.1f per accepted POST)" % (writes, writes / posts if posts else 0))
+        misuse = after["scan_misuse"] - before["scan_misuse"]
+        if misuse:
+            stats.error("scan results used after they were freed %d times" % misuse)
+        for route, s in after["routes"].items():
+            print("  %-9s admitted %6d  busy %5d  rate limited %5d  in flight %d" % (
+                route, s["admitted"], s["busy"], s["rate_limited"], s["in_flight"]))
+
+    if stats.error_count:
+        print()
+        print("%d errors, first %d:" % (stats.error_count, len(stats.errors)))
+        for e in stats.errors:
+            print("  " + e)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,26 @@
+#include "FSStorage.h"
+
+String FSStorage::read(const String &key) {
+    String fn = path(key);
+    if (checkExists && !fs.exists(fn)) return "";
+    File f = fs.open(fn, "r");
+    if (!f) return "";
+    String r = f.readString();
+    f.close();
+    return r;
+}
+
+bool FSStorage::write(const String &key, const String &value) {
+    String fn = path(key);
+    if (value.isEmpty())
+        return fs.exists(fn) ? fs.remove(fn) : true;
+    File f = fs.open(fn, "w", true);
+    if (!f) return false;
+    auto w = f.print(value);
+    f.close();
+    return w == value.length();
+}
+
+bool FSStorage::exists(const String &key) {
+    return fs.exists(path(key));
+}
@@ -0,0 +1,32 @@
+#ifndef FSStorage_h
+#define FSStorage_h
+
+#include <FS.h>
+
+#include "HeadlessWiFiSettingsStorage.h"
+
+// One file per key on an Arduino filesystem such as SPIFFS or LittleFS.
+// The filesystem must be mounted by the application. On LittleFS a prefix
+// like "/settings/" keeps the files in their own directory.
+//
+// read() opens the file directly and treats a failed open as an absent key.
+// LittleFS logs an error for every missing file it is asked to open; pass
+// checkExists = true there to test with exists() first instead.
+class FSStorage : public HeadlessWiFiSettingsStorage {
+    public:
+        explicit FSStorage(fs::FS &fs, const char *prefix = "/", bool checkExists = false)
+            : fs(fs), prefix(prefix), checkExists(checkExists) {}
+
+        String read(const String &key) override;
+        bool write(const String &key, const String &value) override;
+        bool exists(const String &key) override;
+
+    private:
+        String path(const String &key) const { return prefix + key; }
+
+        fs::FS &fs;
+        String prefix;
+        bool checkExists;
+};
+
+#endif
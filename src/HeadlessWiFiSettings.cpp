@@ -1,6 +1,6 @@
 #include "HeadlessWiFiSettings.h"
+#include "FSStorage.h"
 
-#define ESPFS SPIFFS
 #define ESPMAC (Sprintf("%06" PRIx32, ((uint32_t)(ESP.getEfuseMac() >> 24))))
 
 #include <DNSServer.h>
@@ -11,28 +11,27 @@
 #include <esp_wifi.h>
 #include <limits.h>
 
+#include <memory>
 #include <vector>
+#include "change_log.h"
+#include "chunk_filler.h"
+#include "connect_cache.h"
 #include "json_utils.h"
+#include "log_ring.h"
+#include "route_limiter.h"
 
 #define Sprintf(f, ...) ({ char* s; asprintf(&s, f, __VA_ARGS__); String r = s; free(s); r; })
 
 namespace { // Helpers
-    String slurp(const String &fn) {
-        File f = ESPFS.open(fn, "r");
-        String r = f.readString();
-        f.close();
-        return r;
-    }
+#if HWS_LOG_LEVEL > HWS_LOG_LEVEL_NONE
+    HwsLogRing<HWS_LOG_SLOTS, HWS_LOG_LINE_LENGTH> logRing;
+#endif
 
-    bool spurt(const String &fn, const String &content) {
-        if (content.isEmpty())
-            return ESPFS.exists(fn) ? ESPFS.remove(fn) : true;
-        File f = ESPFS.open(fn, "w");
-        if (!f) return false;
-        auto w = f.print(content);
-        f.close();
-        return w == content.length();
-    }
+    FSStorage spiffsStorage(SPIFFS);
+
+    HeadlessWiFiSettingsStorage &storage() { return *HeadlessWiFiSettings.storage; }
+
+    ChangeLog &changeLog();
 
     enum class ParamType {
         Dropdown,
@@ -51,16 +50,15 @@ namespace { // Helpers
         long min = LONG_MIN;
         long max = LONG_MAX;
         ParamType type;
+        uint32_t changed = 0;  // generation of the last store() that changed the value
 
-        String filename() {
-            String fn = "/";
-            fn += name;
-            return fn;
-        }
-
-        bool store() { return (name && name.length()) ? spurt(filename(), value) : true; }
+        bool store() { return (name && name.length()) ? storage().write(name, value) : true; }
 
-        void fill() { if (name && name.length()) value = slurp(filename()); }
+        void fill() {
+            if (!name || !name.length()) return;
+            value = storage().read(name);
+            changed = changeLog().stampOf(name);
+        }
 
         virtual void set(const String &) = 0;
 
@@ -226,6 +224,209 @@ namespace { // Helpers
         endpointParams.push_back({});
         return endpointNames.size() - 1;
     }
+
+    ChangeLog loadedChangeLog;
+    bool changeLogLoaded = false;
+
+    bool saveChangeLog() {
+        return storage().write(ChangeLog::KEY, loadedChangeLog.serialize(endpointParams));
+    }
+
+    // Loaded on first use rather than at static initialization, so that an
+    // application can replace the storage before defining parameters. A
+    // missing or unreadable log is started over under a new epoch and saved
+    // right away, so the epoch stays the same across reboots.
+    ChangeLog &changeLog() {
+        if (!changeLogLoaded) {
+            changeLogLoaded = true;
+            if (!loadedChangeLog.parse(storage().read(ChangeLog::KEY))) {
+                loadedChangeLog.reset(esp_random());
+                if (!saveChangeLog()) HWS_LOGW("Failed to store change log");
+            }
+        }
+        return loadedChangeLog;
+    }
+
+    // Stores BSSID, channel and, with `withIp`, the IP configuration of the
+    // current connection for the next connect().
+    bool saveConnectCache(const String &ssid, bool withIp) {
+        const uint8_t *b = WiFi.BSSID();
+        if (!b) return true;
+        ConnectCache cache;
+        memcpy(cache.bssid, b, sizeof(cache.bssid));
+        cache.channel = WiFi.channel();
+        if (withIp) {
+            cache.hasIp = true;
+            cache.ip = WiFi.localIP();
+            cache.gateway = WiFi.gatewayIP();
+            cache.subnet = WiFi.subnetMask();
+            cache.dns = WiFi.dnsIP(0);
+        }
+        String content = cache.serialize(ssid);
+        if (content == storage().read(ConnectCache::KEY)) return true;
+        return storage().write(ConnectCache::KEY, content);
+    }
+
+    // Answers with 503 (too many in flight) or 429 (rate exceeded) and returns
+    // false if the limiter turns the request away. Admitted requests keep
+    // their slot until the connection is closed.
+    bool admit(RouteLimiter &limiter, AsyncWebServerRequest *request) {
+        auto verdict = limiter.acquire(millis());
+        if (verdict == RouteLimiter::Verdict::Admit) {
+            request->onDisconnect([&limiter]() { limiter.release(); });
+            return true;
+        }
+        HWS_LOGV("Rejected %s %s", request->methodToString(), request->url().c_str());
+        bool busy = verdict == RouteLimiter::Verdict::Busy;
+        AsyncWebServerResponse *response = request->beginResponse(busy ? 503 : 429, "text/plain", busy ? "Busy" : "Too Many Requests");
+        response->addHeader("Retry-After", String(limiter.retryAfter()));
+        request->send(response);
+        return false;
+    }
+
+    AsyncWebServerResponse *beginJsonResponse(AsyncWebServerRequest *request, ChunkFiller::Generator next) {
+        auto filler = std::make_shared<ChunkFiller>(next);
+        return request->beginChunkedResponse("application/json; charset=utf-8", [filler](uint8_t *buf, size_t maxLen, size_t) {
+            return filler->fill(buf, maxLen);
+        });
+    }
+
+    // Generators for the chunked JSON responses. Each call produces the next
+    // small piece of the body, so a response never holds more than one
+    // parameter, option or network in RAM.
+
+    // {"values":{...},"defaults":{...}} for one endpoint
+    struct EndpointJson {
+        size_t endpoint;
+        uint8_t section = 0;
+        size_t i = 0;
+        bool needsComma = false;
+
+        explicit EndpointJson(size_t endpoint) : endpoint(endpoint) {}
+
+        bool operator()(String &piece) {
+            auto &params = endpointParams[endpoint];
+            if (section == 0) {
+                piece = "{\"values\":{";
+                section = 1;
+                return true;
+            }
+            if (section > 2) return false;
+            while (i < params.size()) {
+                auto s = section == 1 ? params[i]->jsonValue() : params[i]->jsonDefault();
+                i++;
+                if (s == "") continue;
+                if (needsComma) piece = ",";
+                else piece = "";
+                piece += s;
+                needsComma = true;
+                return true;
+            }
+            piece = section == 1 ? "},\"defaults\":{" : "}}";
+            section++;
+            i = 0;
+            needsComma = false;
+            return true;
+        }
+    };
+
+    // ["option",...] for one dropdown
+    struct OptionsJson {
+        HeadlessWiFiSettingsDropdown *dropdown;
+        size_t i = 0;
+        bool started = false;
+
+        explicit OptionsJson(HeadlessWiFiSettingsDropdown *dropdown) : dropdown(dropdown) {}
+
+        bool operator()(String &piece) {
+            if (!started) {
+                piece = "[";
+                started = true;
+                return true;
+            }
+            if (i > dropdown->options.size()) return false;
+            if (i == dropdown->options.size()) {
+                piece = "]";
+            } else {
+                piece = i ? ",\"" : "\"";
+                piece += json_encode(dropdown->options[i]);
+                piece += "\"";
+            }
+            i++;
+            return true;
+        }
+    };
+
+    // Set while a response still reads the driver's scan results; a new scan
+    // would free them under it. Only touched on the async_tcp task.
+    bool scanInUse = false;
+
+    // Owns the driver's scan results for one response. They are freed when
+    // the body is complete, or when the response is destroyed if the client
+    // went away first.
+    class ScanLease {
+        public:
+            ScanLease() { scanInUse = true; }
+            ~ScanLease() { release(); }
+            ScanLease(const ScanLease &) = delete;
+            ScanLease &operator=(const ScanLease &) = delete;
+
+            void release() {
+                if (!held) return;
+                held = false;
+                WiFi.scanDelete();
+                scanInUse = false;
+            }
+
+        private:
+            bool held = true;
+    };
+
+    // {"networks":{"ssid":rssi,...}} from the current scan results. Hidden
+    // networks are skipped; an SSID seen on several BSSIDs is listed once, at
+    // its first position, with the strongest RSSI.
+    struct ScanJson {
+        int count;
+        std::shared_ptr<ScanLease> lease;  // shared by the copies std::function makes
+        int i = -1;
+        bool needsComma = false;
+
+        ScanJson(int count, std::shared_ptr<ScanLease> lease) : count(count), lease(lease) {}
+
+        bool operator()(String &piece) {
+            if (i < 0) {
+                piece = "{\"networks\":{";
+                i = 0;
+                return true;
+            }
+            while (i < count) {
+                int cur = i++;
+                String ssid = WiFi.SSID(cur);
+                if (ssid.isEmpty()) continue;
+
+                bool seen = false;
+                for (int j = 0; j < cur && !seen; j++) seen = WiFi.SSID(j) == ssid;
+                if (seen) continue;
+
+                int rssi = WiFi.RSSI(cur);
+                for (int j = cur + 1; j < count; j++) {
+                    if (WiFi.RSSI(j) > rssi && WiFi.SSID(j) == ssid) rssi = WiFi.RSSI(j);
+                }
+
+                piece = needsComma ? ",\"" : "\"";
+                piece += json_encode(ssid);
+                piece += "\":";
+                piece += String(rssi);
+                needsComma = true;
+                return true;
+            }
+            if (i > count) return false;
+            i++;
+            lease->release();
+            piece = "}}";
+            return true;
+        }
+    };
 } // namespace
 
 String HeadlessWiFiSettingsClass::pstring(const String &name, const String &init, const String &label) {
@@ -358,12 +559,12 @@ void HeadlessWiFiSettingsClass::httpSetup(bool wifi) {
     };
 
     // Get dropdown options endpoint
-    http.on("/wifi/options/", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    http.on("/wifi/options", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        if (!admit(limits.options, request)) return;
         String path = request->url();
-        Serial.print("GET ");
-        Serial.println(path);
+        HWS_LOGD("GET %s", path.c_str());
 
-        String paramName = path.substring(13); // Remove "/wifi/options/"
+        String paramName = path.substring(14); // Remove "/wifi/options/"
 
         // Search all endpoints for the parameter
         HeadlessWiFiSettingsDropdown* dropdown = nullptr;
@@ -384,76 +585,44 @@ void HeadlessWiFiSettingsClass::httpSetup(bool wifi) {
             return;
         }
 
-        AsyncResponseStream *response = request->beginResponseStream("application/json; charset=utf-8");
-        response->print("[");
-        bool needsComma = false;
-        for (const auto& option : dropdown->options) {
-            if (needsComma) response->print(",");
-            response->printf("\"%s\"", json_encode(option).c_str());
-            needsComma = true;
-        }
-        response->print("]");
-        request->send(response);
+        request->send(beginJsonResponse(request, OptionsJson(dropdown)));
     });
 
-    http.on("/wifi/scan", HTTP_GET, [](AsyncWebServerRequest *request) {
-        String path = request->url();
-        Serial.print("GET ");
-        Serial.println(path);
-
-        int numNetworks = WiFi.scanNetworks();
-        AsyncResponseStream *response = request->beginResponseStream("application/json; charset=utf-8");
-        response->print("{\"networks\":{");
-
-        bool needsComma = false;
-        struct Network {
-            String ssid;
-            int rssi;
-        };
-        std::vector<Network> networks;
-
-        // First pass: collect all networks with their RSSI values
-        for (int i = 0; i < numNetworks; i++) {
-            String ssid = WiFi.SSID(i);
-            if (ssid.isEmpty()) continue;  // Skip hidden networks
-
-            int rssi = WiFi.RSSI(i);
-            bool found = false;
-
-            // Update existing network if we've seen it before
-            for (auto& network : networks) {
-                if (network.ssid == ssid) {
-                    if (rssi > network.rssi) {
-                        network.rssi = rssi;  // Keep the highest RSSI value
-                    }
-                    found = true;
-                    break;
-                }
-            }
-
-            // Add new network if we haven't seen it
-            if (!found) {
-                networks.push_back({ssid, rssi});
-            }
-        }
+    http.on("/wifi/scan", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        if (!admit(limits.scan, request)) return;
+        HWS_LOGD("GET %s", request->url().c_str());
 
-        // Second pass: output the networks with their highest RSSI values
-        for (const auto& network : networks) {
-            if (needsComma) response->print(",");
-            response->printf("\"%s\":%d", json_encode(network.ssid).c_str(), network.rssi);
-            needsComma = true;
+        // Checked regardless of limits.scan, which may allow overlapping scans.
+        if (scanInUse) {
+            AsyncWebServerResponse *response = request->beginResponse(503, "text/plain", "Scan in progress");
+            response->addHeader("Retry-After", "1");
+            request->send(response);
+            return;
         }
+        auto lease = std::make_shared<ScanLease>();
+        int numNetworks = WiFi.scanNetworks();
+        request->send(beginJsonResponse(request, ScanJson(numNetworks < 0 ? 0 : numNetworks, lease)));
+    });
 
-        response->print("}}");
-        request->send(response);
-        WiFi.scanDelete();
+    // Parameters changed since a generation, for incremental mirroring
+    http.on("/wifi/changes", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        if (!admit(limits.get, request)) return;
+        HWS_LOGD("GET %s", request->url().c_str());
+
+        // Without the epoch of this log the client's generation means
+        // nothing here: it never synced, or the log was started over since.
+        const ChangeLog &log = changeLog();
+        bool reset = request->arg("epoch") != log.epochId();
+        long since = request->arg("since").toInt();
+        if (since < 0) since = 0;
+        request->send(beginJsonResponse(request, ChangesJson<HeadlessWiFiSettingsParameter>(endpointNames, endpointParams, log, since, reset)));
     });
 
     // Handler for /wifi/{name} endpoints
     http.on("/wifi", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        if (!admit(limits.get, request)) return;
         String path = request->url();
-        Serial.print("GET ");
-        Serial.println(path);
+        HWS_LOGD("GET %s", path.c_str());
         String endpointName;
         size_t endpointIndex;
 
@@ -481,40 +650,14 @@ void HeadlessWiFiSettingsClass::httpSetup(bool wifi) {
             return;
         }
 
-        AsyncResponseStream *response = request->beginResponseStream("application/json; charset=utf-8");
-        response->print("{");
-
-        // Output current values
-        response->print("\"values\":{");
-        bool needsComma = false;
-        for (auto &p : endpointParams[endpointIndex]) {
-            auto s = p->jsonValue();
-            if (s == "") continue;
-            if (needsComma) response->print(",");
-            response->print(s);
-            needsComma = true;
-        }
-        response->print("}");
-
-        // Output defaults
-        response->print(",\"defaults\":{");
-        needsComma = false;
-        for (auto &p : endpointParams[endpointIndex]) {
-            auto s = p->jsonDefault();
-            if (s == "") continue;
-            if (needsComma) response->print(",");
-            response->print(s);
-            needsComma = true;
-        }
-        response->print("}}");
-        request->send(response);
+        request->send(beginJsonResponse(request, EndpointJson(endpointIndex)));
     });
 
     // Handler for /wifi/{name} POST endpoints
     http.on("/wifi", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        if (!admit(limits.post, request)) return;
         String path = request->url();
-        Serial.print("POST ");
-        Serial.println(path);
+        HWS_LOGD("POST %s", path.c_str());
 
         String endpointName;
         size_t endpointIndex;
@@ -543,10 +686,46 @@ void HeadlessWiFiSettingsClass::httpSetup(bool wifi) {
             return;
         }
 
-        bool ok = true;
+        // Stamp and persist the change log before any value. If power is lost
+        // in between, a stamp without its new value only makes a mirror
+        // re-read the parameter; a new value without its stamp would be
+        // missed for good.
+        struct Change {
+            HeadlessWiFiSettingsParameter *param;
+            String value;
+            uint32_t changed;
+        };
+        std::vector<Change> changes;
         for (auto &p : endpointParams[endpointIndex]) {
+            String old = p->value;
             p->set(request->arg(p->name));
-            if (!p->store()) ok = false;
+            if (p->value != old) changes.push_back({p, old, p->changed});
+        }
+
+        ChangeLog &log = changeLog();
+        if (!changes.empty()) {
+            log.generation++;
+            for (auto &c : changes) c.param->changed = log.generation;
+            if (!saveChangeLog()) {
+                log.generation--;
+                for (auto &c : changes) {
+                    c.param->value = c.value;
+                    c.param->changed = c.changed;
+                }
+                request->send(500, "text/plain", "Error writing to flash filesystem");
+                return;
+            }
+        }
+
+        // A value that could not be stored is reverted in RAM, so GET keeps
+        // serving what is on flash; its stamp stays and is harmless.
+        bool ok = true;
+        for (auto &p : endpointParams[endpointIndex]) {
+            if (p->store()) continue;
+            ok = false;
+            for (auto &c : changes) {
+                if (c.param == p) p->value = c.value;
+            }
         }
 
         if (ok) {
@@ -557,10 +736,9 @@ void HeadlessWiFiSettingsClass::httpSetup(bool wifi) {
         }
     });
 
-    http.onNotFound([this, &redirect](AsyncWebServerRequest *request) {
-        String path = request->url();
-        Serial.print("GET ");
-        Serial.println(path);
+    http.onNotFound([this, redirect](AsyncWebServerRequest *request) {
+        if (!admit(limits.notFound, request)) return;
+        HWS_LOGD("%s %s", request->methodToString(), request->url().c_str());
         if (redirect(request)) return;
         request->send(404, "text/plain", "404");
     });
@@ -578,15 +756,15 @@ void HeadlessWiFiSettingsClass::portal() {
     }
     WiFi.mode(WIFI_AP);
 
-    Serial.println(F("Starting access point for configuration portal."));
+    HWS_LOGI("Starting access point for configuration portal.");
     if (secure && password.length()) {
-        Serial.printf("SSID: '%s', Password: '%s'\n", hostname.c_str(), password.c_str());
+        HWS_LOGI("SSID: '%s' (password protected)", hostname.c_str());
         if (!WiFi.softAP(hostname.c_str(), password.c_str()))
-            Serial.println("Failed to start access point!");
+            HWS_LOGE("Failed to start access point!");
     } else {
-        Serial.printf("SSID: '%s'\n", hostname.c_str());
+        HWS_LOGI("SSID: '%s'", hostname.c_str());
         if (!WiFi.softAP(hostname.c_str()))
-            Serial.println("Failed to start access point!");
+            HWS_LOGE("Failed to start access point!");
     }
     delay(500);
     DNSServer dns;
@@ -594,8 +772,7 @@ void HeadlessWiFiSettingsClass::portal() {
     dns.start(53, "*", WiFi.softAPIP());
 
     if (onPortal) onPortal();
-    String ip = WiFi.softAPIP().toString();
-    Serial.printf("IP: %s\n", ip.c_str());
+    HWS_LOGI("IP: %s", WiFi.softAPIP().toString().c_str());
 
     httpSetup(true);
 
@@ -607,6 +784,7 @@ void HeadlessWiFiSettingsClass::portal() {
             desired = onPortalWaitLoop();
             starttime = millis();
         }
+        flushLog();
         // Guard WDT reset to avoid "task not found" spam on ESP32 core 3.x
         if (esp_task_wdt_status(NULL) == ESP_OK) {
             esp_task_wdt_reset();
@@ -627,58 +805,133 @@ bool HeadlessWiFiSettingsClass::connect(bool portal, int wait_seconds) {
     WiFi.persistent(false);
     WiFi.setAutoReconnect(false);
 
-    String ssid = slurp("/wifi-ssid");
-    String pw = slurp("/wifi-password");
+    String ssid = storage->read("wifi-ssid");
+    String pw = storage->read("wifi-password");
     if (ssid.length() == 0) {
-        Serial.println(F("First contact!\n"));
+        HWS_LOGI("First contact!");
         this->portal();
     }
 
-    Serial.print(F("Connecting to WiFi SSID '"));
-    Serial.print(ssid);
-    Serial.print(F("'"));
+    HWS_LOGI("Connecting to WiFi SSID '%s'", ssid.c_str());
     if (onConnect) onConnect();
 
     WiFi.setHostname(hostname.c_str());
-    auto status = WiFi.begin(ssid.c_str(), pw.c_str());
+    lastConnect = ConnectStats();
 
     unsigned long const wait_ms = wait_seconds * 1000UL;
     unsigned long starttime = millis();
-    unsigned long lastbegin = starttime;
-    while (status != WL_CONNECTED) {
-        if (millis() - lastbegin > 60000) {
-            lastbegin = millis();
-            Serial.print("*");
-            WiFi.disconnect(true, true);
-            status = WiFi.begin(ssid.c_str(), pw.c_str());
-        } else {
-            Serial.print(".");
+    wl_status_t status = WL_DISCONNECTED;
+
+    // The cached attempt gets at most what is left of the overall wait.
+    unsigned long cachedTimeout = fastReconnectTimeout;
+    if (wait_seconds >= 0 && wait_ms < cachedTimeout) cachedTimeout = wait_ms;
+    bool triedCache = false;
+
+    ConnectCache cache;
+    if (fastReconnect) {
+        String cached = storage->read(ConnectCache::KEY);
+        triedCache = cache.parse(cached, ssid, cacheIp);
+        if (!triedCache && cached.length())
+            HWS_LOGI("Connection cache is for another network or unreadable, scanning");
+    }
+    if (triedCache) {
+        HWS_LOGD("Trying cached BSSID on channel %d", (int)cache.channel);
+        if (cache.hasIp) WiFi.config(cache.ip, cache.gateway, cache.subnet, cache.dns);
+        status = WiFi.begin(ssid.c_str(), pw.c_str(), cache.channel, cache.bssid);
+        while (status != WL_CONNECTED && millis() - starttime < cachedTimeout) {
+            flushLog();
+            delay(onWaitLoop ? onWaitLoop() : 100);
             status = WiFi.status();
         }
-        delay(onWaitLoop ? onWaitLoop() : 100);
-        if (wait_seconds >= 0 && millis() - starttime > wait_ms)
-            break;
+        lastConnect.cachedMillis = millis() - starttime;
+        if (status == WL_CONNECTED) {
+            lastConnect.path = ConnectPath::Cached;
+        } else {
+            HWS_LOGI("Cached connection failed, falling back to full scan");
+            WiFi.disconnect(true, true);
+            if (cache.hasIp) WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+        }
+    }
+
+    bool timedOut = triedCache && wait_seconds >= 0 && millis() - starttime >= wait_ms;
+    if (status != WL_CONNECTED && !timedOut) {
+        unsigned long scanstart = millis();
+        unsigned long lastbegin = scanstart;
+        status = WiFi.begin(ssid.c_str(), pw.c_str());
+        while (status != WL_CONNECTED) {
+            if (millis() - lastbegin > 60000) {
+                lastbegin = millis();
+                HWS_LOGD("Still not connected, restarting WiFi");
+                WiFi.disconnect(true, true);
+                status = WiFi.begin(ssid.c_str(), pw.c_str());
+            } else {
+                status = WiFi.status();
+            }
+            flushLog();
+            delay(onWaitLoop ? onWaitLoop() : 100);
+            if (wait_seconds >= 0 && millis() - starttime > wait_ms)
+                break;
+        }
+        lastConnect.scanMillis = millis() - scanstart;
+        if (status == WL_CONNECTED) lastConnect.path = ConnectPath::Scan;
     }
 
     if (status != WL_CONNECTED) {
-        Serial.printf(" failed (status=%d).\n", status);
+        HWS_LOGW("WiFi connection failed (status=%d).", status);
+        flushLog();
         if (onFailure) onFailure();
         if (portal) this->portal();
         return false;
     }
 
-    Serial.println(WiFi.localIP().toString());
+    HWS_LOGI("Connected, IP: %s (%s, %lu ms)", WiFi.localIP().toString().c_str(),
+             lastConnect.path == ConnectPath::Cached ? "cached" : "scan",
+             lastConnect.cachedMillis + lastConnect.scanMillis);
+    if (fastReconnect && !saveConnectCache(ssid, cacheIp))
+        HWS_LOGW("Failed to store connection cache");
+    flushLog();
     if (onSuccess) onSuccess();
     return true;
 }
 
+void hwsLog(HwsLogLevel level, const char *fmt, ...) {
+#if HWS_LOG_LEVEL > HWS_LOG_LEVEL_NONE
+    va_list args;
+    va_start(args, fmt);
+    logRing.vwrite(level, fmt, args);
+    va_end(args);
+#else
+    (void)level;
+    (void)fmt;
+#endif
+}
+
+size_t HeadlessWiFiSettingsClass::flushLog() {
+#if HWS_LOG_LEVEL > HWS_LOG_LEVEL_NONE
+    return logRing.drain([this](HwsLogLevel level, const char *line) {
+        if (onLog) onLog(level, line);
+        else Serial.printf("[%c] %s\n", hwsLogLevelChar(level), line);
+    });
+#else
+    return 0;
+#endif
+}
+
+uint32_t HeadlessWiFiSettingsClass::droppedLogLines() const {
+#if HWS_LOG_LEVEL > HWS_LOG_LEVEL_NONE
+    return logRing.droppedCount();
+#else
+    return 0;
+#endif
+}
+
 void HeadlessWiFiSettingsClass::begin() {
     if (begun) return;
     begun = true;
     if (hostname.endsWith("-")) hostname += ESPMAC;
 }
 
-HeadlessWiFiSettingsClass::HeadlessWiFiSettingsClass() : http(80) {
+HeadlessWiFiSettingsClass::HeadlessWiFiSettingsClass() : storage(&spiffsStorage), http(80) {
     hostname = F("esp32-");
 }
 
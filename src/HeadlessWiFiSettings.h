@@ -6,11 +6,32 @@
 
 #include <ESPAsyncWebServer.h>
 
+#include "HeadlessWiFiSettingsStorage.h"
+#include "log_ring.h"
+#include "route_limiter.h"
+
 class HeadlessWiFiSettingsClass {
     public:
         typedef std::function<void(void)> TCallback;
         typedef std::function<int(void)> TCallbackReturnsInt;
         typedef std::function<void(String&)> TCallbackString;
+        typedef std::function<void(HwsLogLevel, const char*)> TCallbackLog;
+
+        enum class ConnectPath : uint8_t { None, Cached, Scan };
+        struct ConnectStats {
+            ConnectPath path = ConnectPath::None;  // how the last connect() succeeded
+            unsigned long cachedMillis = 0;        // time spent on the cached BSSID attempt
+            unsigned long scanMillis = 0;          // time spent on the full scan attempt
+        };
+
+        // Concurrency cap, requests per second and burst size for each route.
+        struct RouteLimits {
+            RouteLimiter scan{1, 0.2f, 2};
+            RouteLimiter get{4, 10, 20};
+            RouteLimiter post{1, 1, 3};
+            RouteLimiter options{4, 10, 20};
+            RouteLimiter notFound{4, 10, 20};
+        };
 
         HeadlessWiFiSettingsClass();
         void markExtra();
@@ -29,10 +50,18 @@ class HeadlessWiFiSettingsClass {
         float floating(const String &name, float init = 0, const String &label = "");
         float floating(const String &name, long min, long max, float init = 0, const String &label = "");
         bool checkbox(const String& name, bool init = false, const String& label = "");
+        size_t flushLog();
+        uint32_t droppedLogLines() const;
 
         String hostname;
         String password;
         bool secure;
+        bool fastReconnect = true;
+        bool cacheIp = false;
+        unsigned long fastReconnectTimeout = 5000;
+        ConnectStats lastConnect;
+        HeadlessWiFiSettingsStorage *storage;
+        RouteLimits limits;
 
         std::function<void(AsyncWebServer*)> onHttpSetup;
         TCallback onConnect;
@@ -45,6 +74,7 @@ class HeadlessWiFiSettingsClass {
         TCallback onConfigSaved;
         TCallback onRestart;
         TCallbackReturnsInt onPortalWaitLoop;
+        TCallbackLog onLog;
     private:
         AsyncWebServer http;
         bool begun = false;
@@ -0,0 +1,46 @@
+#ifndef HeadlessWiFiSettingsStorage_h
+#define HeadlessWiFiSettingsStorage_h
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+
+// Where parameter values and the connection cache are persisted. Keys are
+// parameter names without a leading slash; every backend maps them onto its
+// own namespace.
+class HeadlessWiFiSettingsStorage {
+    public:
+        virtual ~HeadlessWiFiSettingsStorage() {}
+
+        // Returns the stored value, or an empty string if the key is absent.
+        virtual String read(const String &key) = 0;
+
+        // Stores value under key. An empty value removes the key, mirroring
+        // how parameters fall back to their init value.
+        virtual bool write(const String &key, const String &value) = 0;
+
+        virtual bool exists(const String &key) = 0;
+};
+
+// Keeps everything in RAM. Useful for native tests and for devices that
+// must never write to flash.
+class MemoryStorage : public HeadlessWiFiSettingsStorage {
+    public:
+        String read(const String &key) override {
+            auto it = values.find(key.c_str());
+            return it == values.end() ? String() : String(it->second.c_str());
+        }
+
+        bool write(const String &key, const String &value) override {
+            if (value.isEmpty()) values.erase(key.c_str());
+            else values[key.c_str()] = value.c_str();
+            return true;
+        }
+
+        bool exists(const String &key) override { return values.count(key.c_str()) > 0; }
+
+    private:
+        std::map<std::string, std::string> values;
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef HostFileStorage_h
+#define HostFileStorage_h
+
+#include <cstdio>
+#include <string>
+
+#include "HeadlessWiFiSettingsStorage.h"
+
+// One file per key in a directory on the build host. Only meant for native
+// tests and host builds; the directory must exist.
+class HostFileStorage : public HeadlessWiFiSettingsStorage {
+    public:
+        explicit HostFileStorage(const std::string &dir) : dir(dir) {}
+
+        String read(const String &key) override {
+            FILE *f = std::fopen(path(key).c_str(), "rb");
+            if (!f) return "";
+            std::string r;
+            char buf[256];
+            size_t n;
+            while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) r.append(buf, n);
+            std::fclose(f);
+            return String(r.c_str());
+        }
+
+        bool write(const String &key, const String &value) override {
+            if (value.isEmpty())
+                return !exists(key) || std::remove(path(key).c_str()) == 0;
+            FILE *f = std::fopen(path(key).c_str(), "wb");
+            if (!f) return false;
+            size_t w = std::fwrite(value.c_str(), 1, value.length(), f);
+            return std::fclose(f) == 0 && w == value.length();
+        }
+
+        bool exists(const String &key) override {
+            FILE *f = std::fopen(path(key).c_str(), "rb");
+            if (f) std::fclose(f);
+            return f != nullptr;
+        }
+
+    private:
+        std::string path(const String &key) const { return dir + "/" + key.c_str(); }
+
+        std::string dir;
+};
+
+#endif
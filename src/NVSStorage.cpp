@@ -0,0 +1,42 @@
+#include "NVSStorage.h"
+
+String NVSStorage::nvsKey(const String &key) {
+    if (key.length() <= 15) return key;
+    uint32_t h = 2166136261u;  // FNV-1a
+    for (unsigned int i = 0; i < key.length(); i++) {
+        h ^= static_cast<uint8_t>(key[i]);
+        h *= 16777619u;
+    }
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%.6s~%08x", key.c_str(), (unsigned int)h);
+    return buf;
+}
+
+bool NVSStorage::open() {
+    if (!opened) opened = prefs.begin(ns, false);
+    return opened;
+}
+
+void NVSStorage::end() {
+    if (opened) prefs.end();
+    opened = false;
+}
+
+String NVSStorage::read(const String &key) {
+    if (!open()) return "";
+    String k = nvsKey(key);
+    if (!prefs.isKey(k.c_str())) return "";
+    return prefs.getString(k.c_str(), "");
+}
+
+bool NVSStorage::write(const String &key, const String &value) {
+    if (!open()) return false;
+    String k = nvsKey(key);
+    if (value.isEmpty())
+        return prefs.isKey(k.c_str()) ? prefs.remove(k.c_str()) : true;
+    return prefs.putString(k.c_str(), value) == value.length();
+}
+
+bool NVSStorage::exists(const String &key) {
+    return open() && prefs.isKey(nvsKey(key).c_str());
+}
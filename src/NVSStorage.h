@@ -0,0 +1,31 @@
+#ifndef NVSStorage_h
+#define NVSStorage_h
+
+#include <Preferences.h>
+
+#include "HeadlessWiFiSettingsStorage.h"
+
+// Stores values as strings in an NVS namespace. NVS keys are limited to 15
+// characters, so longer names are shortened to a prefix plus a hash.
+class NVSStorage : public HeadlessWiFiSettingsStorage {
+    public:
+        explicit NVSStorage(const char *ns = "wifisettings") : ns(ns) {}
+
+        String read(const String &key) override;
+        bool write(const String &key, const String &value) override;
+        bool exists(const String &key) override;
+
+        // Closes the namespace; the next access opens it again.
+        void end();
+
+        static String nvsKey(const String &key);
+
+    private:
+        bool open();
+
+        Preferences prefs;
+        const char *ns;
+        bool opened = false;
+};
+
+#endif
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "json_utils.h"
+
+// Generation counter behind GET /wifi/changes. Every POST that changes at
+// least one stored value bumps the generation and stamps the changed
+// parameters. The epoch is a random id picked whenever the log has to be
+// started from scratch; a client that synced against another epoch has to
+// start over. Persisted in one key as
+// "<epoch, 8 hex digits> <generation>\n<stamp> <name>\n...".
+class ChangeLog {
+    public:
+        static constexpr const char *KEY = "wifi-changes";
+
+        uint32_t epoch = 0;
+        uint32_t generation = 0;
+
+        // Empties the log under a new epoch. 0 is not a valid epoch.
+        void reset(uint32_t newEpoch) {
+            epoch = newEpoch ? newEpoch : 1;
+            generation = 0;
+            stamps.clear();
+        }
+
+        String epochId() const {
+            char buf[9];
+            snprintf(buf, sizeof(buf), "%08lx", (unsigned long)epoch);
+            return buf;
+        }
+
+        // Returns false, leaving an empty log with epoch 0, if the header line
+        // is missing or malformed. Stamp lines that cannot be parsed, or that
+        // are newer than the generation, are skipped.
+        bool parse(const String &content) {
+            epoch = 0;
+            generation = 0;
+            stamps.clear();
+
+            int nl = content.indexOf('\n');
+            String header = nl < 0 ? content : content.substring(0, nl);
+            uint32_t e, g;
+            if (header.length() < 10 || header[8] != ' ') return false;
+            if (!number(header.substring(0, 8), 16, e) || !e) return false;
+            if (!number(header.substring(9), 10, g)) return false;
+            epoch = e;
+            generation = g;
+
+            while (nl >= 0) {
+                int end = content.indexOf('\n', nl + 1);
+                String line = end < 0 ? content.substring(nl + 1) : content.substring(nl + 1, end);
+                nl = end;
+                int sp = line.indexOf(' ');
+                uint32_t stamp;
+                if (sp < 0 || (unsigned int)sp + 1 == line.length()) continue;
+                if (!number(line.substring(0, sp), 10, stamp) || !stamp || stamp > generation) continue;
+                stamps.push_back({line.substring(sp + 1), stamp});
+            }
+            return true;
+        }
+
+        // Generation that last changed `name` according to the parsed log.
+        uint32_t stampOf(const String &name) const {
+            for (auto &s : stamps) {
+                if (s.first == name) return s.second;
+            }
+            return 0;
+        }
+
+        // The stored form, with the stamps taken from the `changed` field of
+        // every named parameter in `endpoints`.
+        template <typename Param>
+        String serialize(const std::vector<std::vector<Param *>> &endpoints) const {
+            String c = epochId();
+            c += " ";
+            c += String(generation);
+            c += "\n";
+            for (auto &params : endpoints) {
+                for (auto &p : params) {
+                    if (!p->changed || !p->name.length()) continue;
+                    c += String(p->changed);
+                    c += " ";
+                    c += p->name;
+                    c += "\n";
+                }
+            }
+            return c;
+        }
+
+    private:
+        // Digits only: no sign, no whitespace, no 0x, nothing above 32 bits.
+        static bool number(const String &s, int base, uint32_t &out) {
+            if (!s.length() || s.length() > (base == 16 ? 8u : 10u)) return false;
+            for (unsigned int i = 0; i < s.length(); i++) {
+                char c = s[i];
+                bool digit = c >= '0' && c <= '9';
+                bool hex = (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+                if (!digit && !(base == 16 && hex)) return false;
+            }
+            unsigned long long v = strtoull(s.c_str(), nullptr, base);
+            if (v > 0xFFFFFFFFull) return false;
+            out = (uint32_t)v;
+            return true;
+        }
+
+        std::vector<std::pair<String, uint32_t>> stamps;
+};
+
+// Chunk generator for GET /wifi/changes:
+// {"epoch":"...","generation":N[,"reset":true],"changes":{"<endpoint>":{...}}}
+// Lists every named parameter stamped after `since`, or with `reset` every
+// named parameter. A parameter without a value is reported as null, meaning
+// its default applies. Param needs `name`, `changed` and `jsonValue()`, which
+// returns "" for an empty value.
+template <typename Param>
+struct ChangesJson {
+    typedef std::vector<std::vector<Param *>> Endpoints;
+
+    const std::vector<String> &names;
+    const Endpoints &endpoints;
+    String epoch;
+    uint32_t generation;
+    uint32_t since;
+    bool reset;
+    size_t endpoint = 0;
+    size_t i = 0;
+    bool started = false;
+    bool endpointOpen = false;
+    bool anyEndpoint = false;
+
+    ChangesJson(const std::vector<String> &names, const Endpoints &endpoints, const ChangeLog &log, uint32_t since, bool reset)
+        : names(names), endpoints(endpoints), epoch(log.epochId()), generation(log.generation), since(since), reset(reset) {}
+
+    bool operator()(String &piece) {
+        if (!started) {
+            started = true;
+            piece = "{\"epoch\":\"";
+            piece += epoch;
+            piece += "\",\"generation\":";
+            piece += String(generation);
+            if (reset) piece += ",\"reset\":true";
+            piece += ",\"changes\":{";
+            return true;
+        }
+        while (endpoint < endpoints.size()) {
+            auto &params = endpoints[endpoint];
+            while (i < params.size()) {
+                auto p = params[i++];
+                if (!p->name.length() || (!reset && p->changed <= since)) continue;
+                if (endpointOpen) {
+                    piece = ",";
+                } else {
+                    piece = anyEndpoint ? ",\"" : "\"";
+                    piece += json_encode(names[endpoint]);
+                    piece += "\":{";
+                    endpointOpen = anyEndpoint = true;
+                }
+                auto s = p->jsonValue();
+                if (s == "") {
+                    piece += "\"";
+                    piece += json_encode(p->name);
+                    piece += "\":null";
+                } else {
+                    piece += s;
+                }
+                return true;
+            }
+            endpoint++;
+            i = 0;
+            if (endpointOpen) {
+                endpointOpen = false;
+                piece = "}";
+                return true;
+            }
+        }
+        if (endpoint > endpoints.size()) return false;
+        endpoint++;
+        piece = "}}";
+        return true;
+    }
+};
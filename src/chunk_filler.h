@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstring>
+#include <functional>
+
+// Adapts a generator that produces a response body one small piece at a time
+// to the filler callback of AsyncWebServerRequest::beginChunkedResponse().
+// Only the piece currently being sent is held in memory, so peak RAM does
+// not grow with the size of the body.
+class ChunkFiller {
+    public:
+        // Stores the next piece and returns true, or returns false at the end.
+        typedef std::function<bool(String &)> Generator;
+
+        explicit ChunkFiller(Generator next) : next(next) {}
+
+        // Copies up to maxLen bytes into buf; returns 0 once the body is done.
+        size_t fill(uint8_t *buf, size_t maxLen) {
+            size_t n = 0;
+            while (n < maxLen) {
+                if (offset == piece.length()) {
+                    offset = 0;
+                    if (done || !next(piece)) {
+                        done = true;
+                        piece = String();
+                        break;
+                    }
+                    continue;
+                }
+                size_t len = piece.length() - offset;
+                if (len > maxLen - n) len = maxLen - n;
+                memcpy(buf + n, piece.c_str() + offset, len);
+                n += len;
+                offset += len;
+            }
+            return n;
+        }
+
+    private:
+        Generator next;
+        String piece;
+        size_t offset = 0;
+        bool done = false;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <cstdint>
+#include <cstdio>
+
+// BSSID, channel and optionally the IP configuration of the last successful
+// connection, so the next connect() can skip the scan and DHCP.
+struct ConnectCache {
+    static constexpr const char *KEY = "wifi-cache";
+
+    uint8_t bssid[6] = {};
+    int32_t channel = 0;
+    bool hasIp = false;
+    IPAddress ip, gateway, subnet, dns;
+
+    // Line 1: BSSID and channel, line 2: ip, gateway, subnet and dns (empty
+    // without hasIp), rest: the SSID the entry belongs to.
+    String serialize(const String &ssid) const {
+        char line[32];
+        snprintf(line, sizeof(line), "%02x:%02x:%02x:%02x:%02x:%02x %d\n",
+                 bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5], (int)channel);
+        String r = line;
+        if (hasIp) {
+            r += ip.toString() + " " + gateway.toString() + " ";
+            r += subnet.toString() + " " + dns.toString();
+        }
+        r += "\n";
+        r += ssid;
+        return r;
+    }
+
+    // Returns false unless `content` is a complete entry for `ssid`. The IP
+    // configuration is only taken if `withIp` is set and all four addresses
+    // are present; otherwise hasIp is false and DHCP is used.
+    bool parse(const String &content, const String &ssid, bool withIp) {
+        int nl1 = content.indexOf('\n');
+        int nl2 = nl1 < 0 ? -1 : content.indexOf('\n', nl1 + 1);
+        if (nl2 < 0 || content.substring(nl2 + 1) != ssid) return false;
+
+        unsigned int b[6];
+        int ch;
+        if (sscanf(content.c_str(), "%2x:%2x:%2x:%2x:%2x:%2x %d", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &ch) != 7) return false;
+        if (!validChannel(ch)) return false;
+        for (int i = 0; i < 6; i++) bssid[i] = b[i];
+        channel = ch;
+
+        char a[4][16];
+        String ips = content.substring(nl1 + 1, nl2);
+        hasIp = withIp && sscanf(ips.c_str(), "%15s %15s %15s %15s", a[0], a[1], a[2], a[3]) == 4
+            && ip.fromString(a[0]) && gateway.fromString(a[1]) && subnet.fromString(a[2]) && dns.fromString(a[3]);
+        return true;
+    }
+
+    // 2.4 GHz channels 1..14 and the 20 MHz 5 GHz channels, which dual-band
+    // chips such as the ESP32-C5 connect on.
+    static bool validChannel(int ch) {
+        if (ch >= 1 && ch <= 14) return true;
+        if (ch >= 32 && ch <= 144) return ch % 4 == 0;
+        if (ch >= 149 && ch <= 177) return (ch - 149) % 4 == 0;
+        return false;
+    }
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#define HWS_LOG_LEVEL_NONE 0
+#define HWS_LOG_LEVEL_ERROR 1
+#define HWS_LOG_LEVEL_WARN 2
+#define HWS_LOG_LEVEL_INFO 3
+#define HWS_LOG_LEVEL_DEBUG 4
+#define HWS_LOG_LEVEL_VERBOSE 5
+
+// Highest level that is compiled in; everything above it expands to nothing,
+// including the evaluation of its arguments.
+#ifndef HWS_LOG_LEVEL
+#define HWS_LOG_LEVEL HWS_LOG_LEVEL_INFO
+#endif
+
+#ifndef HWS_LOG_SLOTS
+#define HWS_LOG_SLOTS 16
+#endif
+
+#ifndef HWS_LOG_LINE_LENGTH
+#define HWS_LOG_LINE_LENGTH 96
+#endif
+
+enum class HwsLogLevel : uint8_t {
+    Error = HWS_LOG_LEVEL_ERROR,
+    Warn = HWS_LOG_LEVEL_WARN,
+    Info = HWS_LOG_LEVEL_INFO,
+    Debug = HWS_LOG_LEVEL_DEBUG,
+    Verbose = HWS_LOG_LEVEL_VERBOSE
+};
+
+inline char hwsLogLevelChar(HwsLogLevel level) {
+    static const char chars[] = "?EWIDV";
+    auto i = static_cast<uint8_t>(level);
+    return i < sizeof(chars) - 1 ? chars[i] : '?';
+}
+
+// Bounded multi-producer, single-consumer ring of preformatted log lines.
+// Producers claim a slot with a CAS and format straight into it, so writing
+// never blocks and never allocates; when the ring is full the line is dropped
+// and counted. The consumer drains from a task where blocking I/O is fine.
+template <size_t Slots, size_t LineLength>
+class HwsLogRing {
+        static_assert(Slots && (Slots & (Slots - 1)) == 0, "Slots must be a power of two");
+        static_assert(LineLength > 1, "LineLength too small");
+
+        struct Slot {
+            std::atomic<size_t> seq;
+            HwsLogLevel level;
+            char line[LineLength];
+        };
+
+    public:
+        HwsLogRing() {
+            for (size_t i = 0; i < Slots; i++) slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+
+        bool vwrite(HwsLogLevel level, const char *fmt, va_list args) {
+            size_t pos = head.load(std::memory_order_relaxed);
+            Slot *slot;
+            for (;;) {
+                slot = &slots[pos & (Slots - 1)];
+                size_t seq = slot->seq.load(std::memory_order_acquire);
+                // Subtract unsigned: converting first overflows once the counters pass 2^31.
+                auto diff = static_cast<intptr_t>(seq - pos);
+                if (diff == 0) {
+                    if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                } else {
+                    pos = head.load(std::memory_order_relaxed);
+                }
+            }
+            slot->level = level;
+            std::vsnprintf(slot->line, LineLength, fmt, args);
+            slot->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool write(HwsLogLevel level, const char *fmt, ...) __attribute__((format(printf, 3, 4))) {
+            va_list args;
+            va_start(args, fmt);
+            bool ok = vwrite(level, fmt, args);
+            va_end(args);
+            return ok;
+        }
+
+        // Hands up to `max` completed lines to sink(HwsLogLevel, const char*)
+        // in order. A concurrent drain returns 0 instead of waiting.
+        template <typename Sink>
+        size_t drain(Sink sink, size_t max = Slots) {
+            if (draining.test_and_set(std::memory_order_acquire)) return 0;
+            size_t n = 0;
+            while (n < max) {
+                Slot &slot = slots[tail & (Slots - 1)];
+                if (slot.seq.load(std::memory_order_acquire) != tail + 1) break;
+                sink(slot.level, static_cast<const char *>(slot.line));
+                slot.seq.store(tail + Slots, std::memory_order_release);
+                tail++;
+                n++;
+            }
+            draining.clear(std::memory_order_release);
+            return n;
+        }
+
+        uint32_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+        Slot slots[Slots];
+        std::atomic<size_t> head{0};
+        size_t tail = 0;
+        std::atomic<uint32_t> dropped{0};
+        std::atomic_flag draining = ATOMIC_FLAG_INIT;
+};
+
+// Appends a line to the library's log ring; defined in HeadlessWiFiSettings.cpp.
+void hwsLog(HwsLogLevel level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+#if HWS_LOG_LEVEL >= HWS_LOG_LEVEL_ERROR
+#define HWS_LOGE(...) hwsLog(HwsLogLevel::Error, __VA_ARGS__)
+#else
+#define HWS_LOGE(...) do {} while (0)
+#endif
+
+#if HWS_LOG_LEVEL >= HWS_LOG_LEVEL_WARN
+#define HWS_LOGW(...) hwsLog(HwsLogLevel::Warn, __VA_ARGS__)
+#else
+#define HWS_LOGW(...) do {} while (0)
+#endif
+
+#if HWS_LOG_LEVEL >= HWS_LOG_LEVEL_INFO
+#define HWS_LOGI(...) hwsLog(HwsLogLevel::Info, __VA_ARGS__)
+#else
+#define HWS_LOGI(...) do {} while (0)
+#endif
+
+#if HWS_LOG_LEVEL >= HWS_LOG_LEVEL_DEBUG
+#define HWS_LOGD(...) hwsLog(HwsLogLevel::Debug, __VA_ARGS__)
+#else
+#define HWS_LOGD(...) do {} while (0)
+#endif
+
+#if HWS_LOG_LEVEL >= HWS_LOG_LEVEL_VERBOSE
+#define HWS_LOGV(...) hwsLog(HwsLogLevel::Verbose, __VA_ARGS__)
+#else
+#define HWS_LOGV(...) do {} while (0)
+#endif
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Admission control for one HTTP route: a cap on requests in flight plus a
+// token bucket. acquire(), release() and retryAfter() are called from the
+// async_tcp task only; the counters are atomic so the application may read
+// them anywhere. configure() may be called from any task at any time: it
+// only publishes the new settings, and the next acquire() applies them.
+// Neither side ever waits for the other, so a configure() from a task with a
+// higher priority than async_tcp cannot livelock on a single core.
+class RouteLimiter {
+    public:
+        enum class Verdict : uint8_t { Admit, Busy, RateLimited };
+
+        struct Stats {
+            uint32_t admitted;
+            uint32_t busy;         // rejected because maxConcurrent was reached
+            uint32_t rateLimited;  // rejected because the bucket was empty
+            uint16_t inFlight;
+        };
+
+        // 0 disables the respective limit.
+        RouteLimiter(uint16_t maxConcurrent, float ratePerSecond, float burst) {
+            apply(maxConcurrent, ratePerSecond, burst);
+        }
+
+        ~RouteLimiter() { delete pending.exchange(nullptr, std::memory_order_acquire); }
+
+        // Takes effect at the next acquire(); the bucket starts full. Whoever
+        // exchanges the pointer owns the settings it held, so there is no lock.
+        void configure(uint16_t maxConcurrent, float ratePerSecond, float burst) {
+            Settings *replaced = pending.exchange(new Settings{maxConcurrent, ratePerSecond, burst}, std::memory_order_acq_rel);
+            delete replaced;  // never applied, superseded by this call
+        }
+
+        Verdict acquire(unsigned long nowMs) {
+            if (Settings *next = pending.exchange(nullptr, std::memory_order_acquire)) {
+                apply(next->maxConcurrent, next->ratePerSecond, next->burst);
+                delete next;
+            }
+            if (maxConcurrent && inFlight.load(std::memory_order_relaxed) >= maxConcurrent) {
+                busy.fetch_add(1, std::memory_order_relaxed);
+                return Verdict::Busy;
+            }
+            if (ratePerSecond > 0) {
+                refill(nowMs);
+                if (tokens < 1) {
+                    rateLimited.fetch_add(1, std::memory_order_relaxed);
+                    return Verdict::RateLimited;
+                }
+                tokens -= 1;
+            }
+            inFlight.fetch_add(1, std::memory_order_relaxed);
+            admitted.fetch_add(1, std::memory_order_relaxed);
+            return Verdict::Admit;
+        }
+
+        void release() {
+            uint16_t n = inFlight.load(std::memory_order_relaxed);
+            while (n && !inFlight.compare_exchange_weak(n, n - 1, std::memory_order_relaxed)) {}
+        }
+
+        // Whole seconds a rejected client should wait, for Retry-After.
+        uint32_t retryAfter() const {
+            if (ratePerSecond <= 0 || tokens >= 1) return 1;
+            auto s = static_cast<uint32_t>((1 - tokens) / ratePerSecond + 0.999f);
+            return s ? s : 1;
+        }
+
+        Stats stats() const {
+            return {admitted.load(std::memory_order_relaxed), busy.load(std::memory_order_relaxed),
+                    rateLimited.load(std::memory_order_relaxed), inFlight.load(std::memory_order_relaxed)};
+        }
+
+    private:
+        struct Settings {
+            uint16_t maxConcurrent;
+            float ratePerSecond;
+            float burst;
+        };
+
+        void apply(uint16_t maxConcurrent, float ratePerSecond, float burst) {
+            this->maxConcurrent = maxConcurrent;
+            this->ratePerSecond = ratePerSecond;
+            this->burst = burst < 1 ? 1 : burst;
+            tokens = this->burst;
+            started = false;
+        }
+
+        void refill(unsigned long nowMs) {
+            if (started) {
+                tokens += static_cast<float>(nowMs - lastRefill) * ratePerSecond / 1000.0f;
+                if (tokens > burst) tokens = burst;
+            }
+            started = true;
+            lastRefill = nowMs;
+        }
+
+        uint16_t maxConcurrent;
+        float ratePerSecond;
+        float burst;
+        float tokens;
+        bool started;
+        unsigned long lastRefill = 0;
+
+        std::atomic<Settings *> pending{nullptr};
+
+        std::atomic<uint16_t> inFlight{0};
+        std::atomic<uint32_t> admitted{0};
+        std::atomic<uint32_t> busy{0};
+        std::atomic<uint32_t> rateLimited{0};
+};
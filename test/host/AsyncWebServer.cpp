@@ -0,0 +1,298 @@
+#include <ESPAsyncWebServer.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <mutex>
+#include <thread>
+
+namespace {
+    // Handlers, response fillers and request teardown all run under this
+    // lock, standing in for the single async_tcp task on the ESP32. Socket
+    // I/O happens outside of it, so slow clients overlap like they do there.
+    std::mutex asyncTcp;
+
+    const String emptyString;
+
+    std::string lower(std::string s) {
+        for (auto &c : s) c = (char)tolower((unsigned char)c);
+        return s;
+    }
+
+    std::string urlDecode(const std::string &s) {
+        std::string r;
+        for (size_t i = 0; i < s.size(); i++) {
+            if (s[i] == '+') {
+                r += ' ';
+            } else if (s[i] == '%' && i + 2 < s.size() && isxdigit((unsigned char)s[i + 1]) && isxdigit((unsigned char)s[i + 2])) {
+                r += (char)strtol(s.substr(i + 1, 2).c_str(), nullptr, 16);
+                i += 2;
+            } else {
+                r += s[i];
+            }
+        }
+        return r;
+    }
+
+    void parseArgs(const std::string &s, std::map<std::string, String> &args) {
+        size_t start = 0;
+        while (start < s.size()) {
+            size_t end = s.find('&', start);
+            if (end == std::string::npos) end = s.size();
+            std::string pair = s.substr(start, end - start);
+            size_t eq = pair.find('=');
+            if (!pair.empty())
+                args[urlDecode(pair.substr(0, eq))] = String(eq == std::string::npos ? std::string() : urlDecode(pair.substr(eq + 1)));
+            start = end + 1;
+        }
+    }
+
+    WebRequestMethodComposite parseMethod(const std::string &m) {
+        if (m == "GET") return HTTP_GET;
+        if (m == "POST") return HTTP_POST;
+        if (m == "DELETE") return HTTP_DELETE;
+        if (m == "PUT") return HTTP_PUT;
+        if (m == "PATCH") return HTTP_PATCH;
+        if (m == "HEAD") return HTTP_HEAD;
+        if (m == "OPTIONS") return HTTP_OPTIONS;
+        return 0;
+    }
+
+    const char *reason(int code) {
+        switch (code) {
+            case 200: return "OK";
+            case 302: return "Found";
+            case 400: return "Bad Request";
+            case 404: return "Not Found";
+            case 429: return "Too Many Requests";
+            case 500: return "Internal Server Error";
+            case 503: return "Service Unavailable";
+            default: return "";
+        }
+    }
+
+    bool sendAll(int fd, const char *buf, size_t len) {
+        while (len) {
+            ssize_t n = ::send(fd, buf, len, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            buf += n;
+            len -= n;
+        }
+        return true;
+    }
+
+    bool readRequest(int fd, AsyncWebServerRequest &r) {
+        std::string buf;
+        char tmp[2048];
+        size_t headerEnd;
+        while ((headerEnd = buf.find("\r\n\r\n")) == std::string::npos) {
+            if (buf.size() > 16384) return false;
+            ssize_t n = recv(fd, tmp, sizeof(tmp), 0);
+            if (n <= 0) return false;
+            buf.append(tmp, n);
+        }
+
+        size_t lineEnd = buf.find("\r\n");
+        std::string line = buf.substr(0, lineEnd);
+        size_t sp1 = line.find(' '), sp2 = line.rfind(' ');
+        if (sp1 == std::string::npos || sp2 <= sp1) return false;
+        r.method_ = parseMethod(line.substr(0, sp1));
+        std::string target = line.substr(sp1 + 1, sp2 - sp1 - 1);
+
+        size_t pos = lineEnd + 2;
+        while (pos < headerEnd) {
+            size_t end = buf.find("\r\n", pos);
+            std::string h = buf.substr(pos, end - pos);
+            size_t colon = h.find(':');
+            if (colon != std::string::npos) {
+                size_t v = h.find_first_not_of(' ', colon + 1);
+                r.headers_[lower(h.substr(0, colon))] = String(v == std::string::npos ? std::string() : h.substr(v));
+            }
+            pos = end + 2;
+        }
+
+        std::string body = buf.substr(headerEnd + 4);
+        size_t contentLength = strtoul(r.header("Content-Length").c_str(), nullptr, 10);
+        if (contentLength > 65536) return false;
+        while (body.size() < contentLength) {
+            ssize_t n = recv(fd, tmp, sizeof(tmp), 0);
+            if (n <= 0) return false;
+            body.append(tmp, n);
+        }
+        body.resize(contentLength);
+
+        size_t q = target.find('?');
+        r.url_ = String(urlDecode(target.substr(0, q)));
+        if (q != std::string::npos) parseArgs(target.substr(q + 1), r.args_);
+        if (r.header("Content-Type").startsWith("application/x-www-form-urlencoded")) parseArgs(body, r.args_);
+        r.host_ = r.header("Host");
+        return true;
+    }
+
+    void writeResponse(int fd, AsyncWebServerResponse *res) {
+        std::string head = "HTTP/1.1 " + std::to_string(res->code) + " " + reason(res->code) + "\r\n";
+        if (res->contentType.length()) head += std::string("Content-Type: ") + res->contentType.c_str() + "\r\n";
+        for (auto &h : res->headers) head += std::string(h.first.c_str()) + ": " + h.second.c_str() + "\r\n";
+        head += "Connection: close\r\n";
+
+        if (!res->filler) {
+            head += "Content-Length: " + std::to_string(res->content.size()) + "\r\n\r\n";
+            sendAll(fd, head.data(), head.size()) && sendAll(fd, res->content.data(), res->content.size());
+            return;
+        }
+
+        head += "Transfer-Encoding: chunked\r\n\r\n";
+        if (!sendAll(fd, head.data(), head.size())) return;
+        uint8_t buf[1436];  // a TCP segment minus chunk framing, like on the ESP32
+        size_t index = 0;
+        for (;;) {
+            size_t n;
+            {
+                std::lock_guard<std::mutex> lock(asyncTcp);
+                n = res->filler(buf, sizeof(buf), index);
+            }
+            if (n == 0) break;
+            index += n;
+            char size[16];
+            int len = snprintf(size, sizeof(size), "%zx\r\n", n);
+            if (!sendAll(fd, size, len) || !sendAll(fd, (const char *)buf, n) || !sendAll(fd, "\r\n", 2)) return;
+        }
+        sendAll(fd, "0\r\n\r\n", 5);
+    }
+
+    void serveConnection(AsyncWebServer *server, int fd) {
+        auto *request = new AsyncWebServerRequest();
+        if (readRequest(fd, *request)) {
+            {
+                std::lock_guard<std::mutex> lock(asyncTcp);
+                server->handle(request);
+            }
+            writeResponse(fd, request->response_.get());
+        }
+        close(fd);
+        std::lock_guard<std::mutex> lock(asyncTcp);
+        delete request;
+    }
+}
+
+const char *AsyncWebServerRequest::methodToString() const {
+    switch (method_) {
+        case HTTP_GET: return "GET";
+        case HTTP_POST: return "POST";
+        case HTTP_DELETE: return "DELETE";
+        case HTTP_PUT: return "PUT";
+        case HTTP_PATCH: return "PATCH";
+        case HTTP_HEAD: return "HEAD";
+        case HTTP_OPTIONS: return "OPTIONS";
+        default: return "UNKNOWN";
+    }
+}
+
+const String &AsyncWebServerRequest::arg(const String &name) const {
+    auto it = args_.find(name.c_str());
+    return it == args_.end() ? emptyString : it->second;
+}
+
+bool AsyncWebServerRequest::hasHeader(const char *name) const {
+    return headers_.count(lower(name)) > 0;
+}
+
+String AsyncWebServerRequest::header(const char *name) const {
+    auto it = headers_.find(lower(name));
+    return it == headers_.end() ? String() : it->second;
+}
+
+void AsyncWebServerRequest::send(int code, const String &contentType, const String &content) {
+    send(beginResponse(code, contentType, content));
+}
+
+void AsyncWebServerRequest::redirect(const String &url) {
+    AsyncWebServerResponse *response = beginResponse(302);
+    response->addHeader("Location", url);
+    send(response);
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse(int code, const String &contentType, const String &content) {
+    auto *response = new AsyncWebServerResponse(code, contentType);
+    response->content = content.c_str();
+    return response;
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginChunkedResponse(const String &contentType, AwsResponseFiller callback) {
+    auto *response = new AsyncWebServerResponse(200, contentType);
+    response->filler = callback;
+    return response;
+}
+
+// Same matching rules as AsyncCallbackWebHandler: the exact URI, or the URI
+// followed by a path separator.
+bool AsyncCallbackWebHandler::canHandle(const AsyncWebServerRequest *request) const {
+    if (!(method & request->method())) return false;
+    return request->url() == uri || request->url().startsWith(uri + "/");
+}
+
+AsyncWebServer::AsyncWebServer(uint16_t port) : port(port) {}
+
+AsyncWebServer::~AsyncWebServer() { end(); }
+
+AsyncCallbackWebHandler &AsyncWebServer::on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest) {
+    handlers.emplace_back(new AsyncCallbackWebHandler(uri, method, onRequest));
+    return *handlers.back();
+}
+
+void AsyncWebServer::handle(AsyncWebServerRequest *request) {
+    for (auto &h : handlers) {
+        if (h->canHandle(request)) {
+            h->fn(request);
+            break;
+        }
+    }
+    if (!request->response_) {
+        if (notFound) notFound(request);
+        else request->send(404);
+    }
+    if (!request->response_) {
+        fprintf(stderr, "No response for %s %s\n", request->methodToString(), request->url().c_str());
+        request->send(500, "text/plain", "No response");
+    }
+}
+
+// Listens on 127.0.0.1. Port 80 becomes $HWS_HOST_PORT, or 8080, so the
+// host build does not need root.
+void AsyncWebServer::begin() {
+    const char *env = getenv("HWS_HOST_PORT");
+    uint16_t p = env ? (uint16_t)atoi(env) : port == 80 ? 8080 : port;
+
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(p);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listenFd, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(listenFd, 128) != 0) {
+        perror("AsyncWebServer::begin");
+        exit(1);
+    }
+    fprintf(stderr, "Listening on http://127.0.0.1:%u/\n", p);
+    std::thread([this] { serve(); }).detach();
+}
+
+void AsyncWebServer::end() {
+    if (listenFd >= 0) close(listenFd);
+    listenFd = -1;
+}
+
+void AsyncWebServer::serve() {
+    for (;;) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (listenFd < 0) return;
+            continue;
+        }
+        std::thread(serveConnection, this, fd).detach();
+    }
+}
@@ -0,0 +1,80 @@
+#include <FS.h>
+
+#include <cerrno>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    bool mkdirs(const std::string &path) {
+        for (size_t p = path.find('/', 1); p != std::string::npos; p = path.find('/', p + 1)) {
+            std::string dir = path.substr(0, p);
+            if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) return false;
+        }
+        return ::mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+    }
+}
+
+fs::FS SPIFFS("spiffs");
+fs::FS LittleFS("littlefs");
+
+namespace fs {
+    size_t File::write(const uint8_t *buf, size_t len) {
+        return fp ? fwrite(buf, 1, len, fp.get()) : 0;
+    }
+
+    size_t File::size() const {
+        struct stat st;
+        return fp && fstat(fileno(fp.get()), &st) == 0 ? st.st_size : 0;
+    }
+
+    String File::readString() {
+        std::string r;
+        char buf[256];
+        size_t n;
+        while (fp && (n = fread(buf, 1, sizeof(buf), fp.get())) > 0) r.append(buf, n);
+        return String(r);
+    }
+
+    // Files live in $HWS_HOST_FS/<name>, "hws-fs/<name>" by default.
+    bool FS::begin(bool, const char *, uint8_t, const char *) {
+        const char *base = getenv("HWS_HOST_FS");
+        root = std::string(base ? base : "hws-fs") + "/" + name;
+        return mkdirs(root);
+    }
+
+    std::string FS::hostPath(const String &path) const {
+        return root + (path.startsWith("/") ? "" : "/") + path.c_str();
+    }
+
+    File FS::open(const String &path, const char *mode, bool create) {
+        std::string p = hostPath(path);
+        bool writing = mode[0] == 'w' || mode[0] == 'a';
+        if (writing && create) mkdirs(p.substr(0, p.rfind('/')));
+        FILE *f = fopen(p.c_str(), writing ? mode : "rb");
+        if (!f) return File();
+        if (writing) writes++;
+        return File(f);
+    }
+
+    bool FS::exists(const String &path) {
+        struct stat st;
+        return stat(hostPath(path).c_str(), &st) == 0;
+    }
+
+    bool FS::remove(const String &path) { return ::remove(hostPath(path).c_str()) == 0; }
+
+    bool FS::mkdir(const String &path) { return mkdirs(hostPath(path)); }
+
+    bool FS::rmdir(const String &path) { return ::rmdir(hostPath(path).c_str()) == 0; }
+
+    bool FS::format() {
+        DIR *d = opendir(root.c_str());
+        if (!d) return false;
+        while (struct dirent *e = readdir(d)) {
+            if (e->d_type == DT_REG) ::remove((root + "/" + e->d_name).c_str());
+        }
+        closedir(d);
+        return true;
+    }
+}
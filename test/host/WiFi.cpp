@@ -0,0 +1,51 @@
+#include <WiFi.h>
+
+#include <vector>
+
+namespace {
+    struct ScanResult {
+        String ssid;
+        int32_t rssi;
+    };
+    std::vector<ScanResult> scanResults;
+}
+
+WiFiClass WiFi;
+
+wl_status_t WiFiClass::begin(const char *, const char *, int32_t, const uint8_t *, bool) {
+    mode_ = WIFI_STA;
+    status_ = WL_CONNECTED;
+    return status_;
+}
+
+// Blocks like a real scan does; HWS_HOST_SCAN_MS sets how long. Like the
+// ESP32 core it frees the previous results first, so a response that is
+// still listing them would lose the rest.
+int16_t WiFiClass::scanNetworks(bool) {
+    if (scanCount_ >= 0) scanMisuse_++;
+    scanCount_ = -2;
+    const char *ms = getenv("HWS_HOST_SCAN_MS");
+    delay(ms ? strtoul(ms, nullptr, 10) : 100);
+    scanCount_ = scanResults.size();
+    return scanCount_;
+}
+
+String WiFiClass::SSID(uint8_t i) {
+    if (scanCount_ < 0) {
+        scanMisuse_++;
+        return String();
+    }
+    return i < scanResults.size() ? scanResults[i].ssid : String();
+}
+
+int32_t WiFiClass::RSSI(uint8_t i) {
+    if (scanCount_ < 0) {
+        scanMisuse_++;
+        return 0;
+    }
+    return i < scanResults.size() ? scanResults[i].rssi : 0;
+}
+
+void WiFiClass::addScanResult(const String &ssid, int32_t rssi) {
+    scanResults.push_back({ssid, rssi});
+}
@@ -0,0 +1,42 @@
+#include <Arduino.h>
+
+#include <chrono>
+#include <cstdarg>
+#include <random>
+#include <thread>
+
+namespace {
+    const auto bootTime = std::chrono::steady_clock::now();
+}
+
+unsigned long millis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+
+unsigned long micros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+
+void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+void yield() { std::this_thread::yield(); }
+
+uint32_t esp_random() {
+    static std::mt19937 rng(std::random_device{}());
+    return rng();
+}
+
+size_t Print::printf(const char *fmt, ...) {
+    char *s = nullptr;
+    va_list args;
+    va_start(args, fmt);
+    int n = vasprintf(&s, fmt, args);
+    va_end(args);
+    if (n < 0) return 0;
+    size_t w = write(reinterpret_cast<const uint8_t *>(s), n);
+    free(s);
+    return w;
+}
+
+HardwareSerial Serial;
+EspClass ESP;
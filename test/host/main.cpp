@@ -0,0 +1,52 @@
+// Host build of the Test example: the library serves its real HTTP routes on
+// 127.0.0.1 with stand-ins for WiFi, SPIFFS and ESPAsyncWebServer. Used with
+// examples/Test/load_test.py.
+//
+// HWS_HOST_PORT       port to listen on (8080)
+// HWS_HOST_FS         directory that holds the SPIFFS files (hws-fs)
+// HWS_HOST_SCAN_MS    how long a WiFi scan blocks (100)
+// HWS_HOST_NO_LIMITS  set to disable the per-route admission limits
+
+#include "../../examples/Test/Test.ino"
+
+namespace {
+    String limiterJson(const char *name, const RouteLimiter &limiter) {
+        auto s = limiter.stats();
+        char buf[160];
+        snprintf(buf, sizeof(buf), "\"%s\":{\"admitted\":%u,\"busy\":%u,\"rate_limited\":%u,\"in_flight\":%u}",
+                 name, s.admitted, s.busy, s.rateLimited, (unsigned)s.inFlight);
+        return buf;
+    }
+
+    void addStatsRoute(AsyncWebServer *http) {
+        http->on("/host/stats", HTTP_GET, [](AsyncWebServerRequest *request) {
+            auto &limits = HeadlessWiFiSettings.limits;
+            String json = "{\"flash_writes\":" + String(SPIFFS.writeCount());
+            json += ",\"scan_misuse\":" + String(WiFi.scanMisuse()) + ",\"routes\":{";
+            json += limiterJson("scan", limits.scan) + ",";
+            json += limiterJson("get", limits.get) + ",";
+            json += limiterJson("post", limits.post) + ",";
+            json += limiterJson("options", limits.options) + ",";
+            json += limiterJson("not_found", limits.notFound) + "}}";
+            request->send(200, "application/json", json);
+        });
+    }
+}
+
+int main() {
+    WiFi.addScanResult("HomeNetwork", -48);
+    WiFi.addScanResult("Neighbour", -71);
+    WiFi.addScanResult("HomeNetwork", -63);
+    WiFi.addScanResult("", -80);
+    WiFi.addScanResult("Caf\xc3\xa9 \"Guest\"", -85);
+
+    if (getenv("HWS_HOST_NO_LIMITS")) {
+        auto &limits = HeadlessWiFiSettings.limits;
+        for (RouteLimiter *l : {&limits.scan, &limits.get, &limits.post, &limits.options, &limits.notFound})
+            l->configure(0, 0, 0);
+    }
+    HeadlessWiFiSettings.onHttpSetup = addStatsRoute;
+
+    setup();
+    for (;;) loop();
+}
@@ -1,19 +1,112 @@
 #pragma once
-#include <string>
+// Host stand-in for the parts of the Arduino core used by the library, for
+// native unit tests and the loopback build. Implementations of the non-inline
+// functions live in test/host.
+#include <cinttypes>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
 class String {
     std::string data;
 public:
     String() {}
     String(const char* s): data(s ? s : "") {}
+    String(const std::string& s): data(s) {}
     String(char c): data(1, c) {}
+    String(unsigned char v): data(std::to_string(v)) {}
+    String(int v): data(std::to_string(v)) {}
+    String(unsigned int v): data(std::to_string(v)) {}
+    String(long v): data(std::to_string(v)) {}
+    String(unsigned long v): data(std::to_string(v)) {}
+    String(float v, unsigned int decimals = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", decimals, (double)v); data = b; }
+    String(double v, unsigned int decimals = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", decimals, v); data = b; }
     size_t length() const { return data.length(); }
     bool isEmpty() const { return data.empty(); }
+    explicit operator bool() const { return true; }
     char operator[](size_t i) const { return data[i]; }
+    char& operator[](size_t i) { return data[i]; }
     String& operator+=(const char* s) { data += s; return *this; }
     String& operator+=(char c) { data.push_back(c); return *this; }
     String& operator+=(const String& other) { data += other.data; return *this; }
+    String& operator+=(long v) { data += std::to_string(v); return *this; }
+    String& operator+=(int v) { data += std::to_string(v); return *this; }
+    String& operator+=(unsigned int v) { data += std::to_string(v); return *this; }
+    String& operator+=(unsigned long v) { data += std::to_string(v); return *this; }
+    friend String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+    friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+    bool operator==(const String& o) const { return data == o.data; }
+    bool operator==(const char* o) const { return data == (o ? o : ""); }
+    bool operator!=(const String& o) const { return data != o.data; }
+    bool operator!=(const char* o) const { return !(*this == o); }
+    bool operator<(const String& o) const { return data < o.data; }
     const char* c_str() const { return data.c_str(); }
+    bool startsWith(const String& p) const { return data.compare(0, p.data.size(), p.data) == 0; }
+    bool endsWith(const String& s) const { return data.size() >= s.data.size() && data.compare(data.size() - s.data.size(), s.data.size(), s.data) == 0; }
+    String substring(size_t from) const { return from >= data.size() ? String() : String(data.substr(from)); }
+    String substring(size_t from, size_t to) const { if (from >= data.size() || to <= from) return String(); return String(data.substr(from, to - from)); }
+    int indexOf(char c, size_t from = 0) const { auto p = data.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+    int indexOf(const String& s, size_t from = 0) const { auto p = data.find(s.data, from); return p == std::string::npos ? -1 : (int)p; }
+    void replace(const String& from, const String& to) {
+        if (from.data.empty()) return;
+        size_t p = 0;
+        while ((p = data.find(from.data, p)) != std::string::npos) { data.replace(p, from.data.size(), to.data); p += to.data.size(); }
+    }
+    void trim() { auto b = data.find_first_not_of(" \t\r\n"); if (b == std::string::npos) { data.clear(); return; } data = data.substr(b, data.find_last_not_of(" \t\r\n") - b + 1); }
+    void toLowerCase() { for (auto& c : data) c = (char)tolower((unsigned char)c); }
+    long toInt() const { return strtol(data.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(data.c_str(), nullptr); }
+    void reserve(size_t n) { data.reserve(n); }
+};
+
+class __FlashStringHelper;
+#define F(s) (s)
+#define PSTR(s) (s)
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+uint32_t esp_random();
+
+class Print;
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
 };
 
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t len) { size_t n = 0; while (len--) n += write(*buf++); return n; }
+    size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+    size_t print(long v) { return print(String(v)); }
+    size_t print(const Printable& p) { return p.printTo(*this); }
+    size_t println(const char* s = "") { return print(s) + print("\n"); }
+    size_t println(const String& s) { return print(s) + print("\n"); }
+    size_t println(const Printable& p) { return print(p) + print("\n"); }
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stderr); }
+    size_t write(const uint8_t* buf, size_t len) override { return fwrite(buf, 1, len, stderr); }
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+    uint64_t getEfuseMac() { return 0x0000A1B2C3D4E5F6ULL; }
+    uint32_t getFreeHeap() { return 0; }
+    void restart() { exit(0); }
+};
+extern EspClass ESP;
@@ -0,0 +1,9 @@
+#pragma once
+#include <IPAddress.h>
+class DNSServer {
+public:
+    void setTTL(uint32_t) {}
+    bool start(uint16_t, const String&, const IPAddress&) { return true; }
+    void processNextRequest() {}
+    void stop() {}
+};
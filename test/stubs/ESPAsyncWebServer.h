@@ -0,0 +1,111 @@
+#pragma once
+#include <Arduino.h>
+#include <WiFi.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Host stand-in for the subset of ESPAsyncWebServer used by the library.
+// Requests are parsed by a small blocking HTTP/1.1 server; handlers and
+// response fillers run one at a time, like they do on the async_tcp task.
+
+typedef enum {
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServerRequest;
+typedef std::function<void(AsyncWebServerRequest*)> ArRequestHandlerFunction;
+typedef std::function<size_t(uint8_t*, size_t, size_t)> AwsResponseFiller;
+typedef std::function<void(void)> ArDisconnectHandler;
+
+class AsyncWebServerResponse {
+public:
+    AsyncWebServerResponse(int code, const String& contentType) : code(code), contentType(contentType) {}
+    virtual ~AsyncWebServerResponse() {}
+    void addHeader(const String& name, const String& value) { headers.emplace_back(name, value); }
+
+    int code;
+    String contentType;
+    std::string content;
+    std::vector<std::pair<String, String>> headers;
+    AwsResponseFiller filler;  // set for chunked responses
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+public:
+    explicit AsyncResponseStream(const String& contentType) : AsyncWebServerResponse(200, contentType) {}
+    size_t write(uint8_t c) override { content.push_back((char)c); return 1; }
+    size_t write(const uint8_t* buf, size_t len) override { content.append((const char*)buf, len); return len; }
+};
+
+class AsyncWebServerRequest {
+public:
+    ~AsyncWebServerRequest() { if (disconnectHandler) disconnectHandler(); }
+
+    const String& url() const { return url_; }
+    const String& host() const { return host_; }
+    WebRequestMethodComposite method() const { return method_; }
+    const char* methodToString() const;
+    bool hasArg(const char* name) const { return args_.count(name) > 0; }
+    const String& arg(const String& name) const;
+    size_t args() const { return args_.size(); }
+    bool hasHeader(const char* name) const;
+    String header(const char* name) const;
+
+    void send(int code, const String& contentType = String(), const String& content = String());
+    void send(AsyncWebServerResponse* response) { response_.reset(response); }
+    void redirect(const String& url);
+    AsyncWebServerResponse* beginResponse(int code, const String& contentType = String(), const String& content = String());
+    AsyncResponseStream* beginResponseStream(const String& contentType, size_t bufferSize = 1460) { (void)bufferSize; return new AsyncResponseStream(contentType); }
+    AsyncWebServerResponse* beginChunkedResponse(const String& contentType, AwsResponseFiller callback);
+    void onDisconnect(ArDisconnectHandler fn) { disconnectHandler = fn; }
+
+    // Host-side plumbing used by the loopback server.
+    String url_, host_;
+    WebRequestMethodComposite method_ = HTTP_GET;
+    std::map<std::string, String> args_;
+    std::map<std::string, String> headers_;
+    std::unique_ptr<AsyncWebServerResponse> response_;
+    ArDisconnectHandler disconnectHandler;
+};
+
+class AsyncCallbackWebHandler {
+public:
+    AsyncCallbackWebHandler(const String& uri, WebRequestMethodComposite method, ArRequestHandlerFunction fn)
+        : uri(uri), method(method), fn(fn) {}
+    bool canHandle(const AsyncWebServerRequest* request) const;
+    String uri;
+    WebRequestMethodComposite method;
+    ArRequestHandlerFunction fn;
+};
+
+class AsyncWebServer {
+public:
+    explicit AsyncWebServer(uint16_t port);
+    ~AsyncWebServer();
+    void begin();
+    void end();
+    AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest);
+    AsyncCallbackWebHandler& on(const char* uri, ArRequestHandlerFunction onRequest) { return on(uri, HTTP_ANY, onRequest); }
+    void onNotFound(ArRequestHandlerFunction fn) { notFound = fn; }
+
+    // Serves one parsed request; used by the loopback server threads.
+    void handle(AsyncWebServerRequest* request);
+
+private:
+    void serve();
+    uint16_t port;
+    int listenFd = -1;
+    std::vector<std::unique_ptr<AsyncCallbackWebHandler>> handlers;
+    ArRequestHandlerFunction notFound;
+};
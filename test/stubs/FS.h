@@ -0,0 +1,49 @@
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <memory>
+
+namespace fs {
+    // Host stand-in for an Arduino file handle, backed by a stdio FILE.
+    class File : public Print {
+    public:
+        File() {}
+        explicit File(FILE* f) : fp(f, fclose) {}
+        explicit operator bool() const { return fp != nullptr; }
+        size_t write(uint8_t c) override { return write(&c, 1); }
+        size_t write(const uint8_t* buf, size_t len) override;
+        size_t read(uint8_t* buf, size_t len) { return fp ? fread(buf, 1, len, fp.get()) : 0; }
+        size_t size() const;
+        String readString();
+        void close() { fp.reset(); }
+    private:
+        std::shared_ptr<FILE> fp;
+    };
+
+    // Host stand-in for a mounted flash filesystem rooted at a directory.
+    // Counts the files opened for writing so load tests can report flash wear.
+    class FS {
+    public:
+        explicit FS(const char* name) : name(name) {}
+        bool begin(bool formatOnFail = false, const char* = "", uint8_t = 10, const char* = nullptr);
+        void end() {}
+        File open(const String& path, const char* mode = "r", bool create = false);
+        bool exists(const String& path);
+        bool remove(const String& path);
+        bool mkdir(const String& path);
+        bool rmdir(const String& path);
+        bool format();
+        uint32_t writeCount() const { return writes.load(); }
+    private:
+        std::string hostPath(const String& path) const;
+        const char* name;
+        std::string root;
+        std::atomic<uint32_t> writes{0};
+    };
+}
+
+using fs::File;
+using fs::FS;
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
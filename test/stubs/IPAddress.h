@@ -0,0 +1,22 @@
+#pragma once
+#include <Arduino.h>
+
+class IPAddress : public Printable {
+    uint8_t octets[4] = {0, 0, 0, 0};
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{a, b, c, d} {}
+    explicit IPAddress(uint32_t v) { memcpy(octets, &v, 4); }
+    operator uint32_t() const { uint32_t v; memcpy(&v, octets, 4); return v; }
+    uint8_t operator[](int i) const { return octets[i]; }
+    bool fromString(const String& s) {
+        unsigned a, b, c, d;
+        if (sscanf(s.c_str(), "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255) return false;
+        octets[0] = a; octets[1] = b; octets[2] = c; octets[3] = d;
+        return true;
+    }
+    size_t printTo(Print& p) const override { return p.print(toString()); }
+    String toString() const { char b[16]; snprintf(b, sizeof(b), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]); return String(b); }
+};
+
+#define INADDR_NONE IPAddress(0, 0, 0, 0)
@@ -0,0 +1,18 @@
+#pragma once
+#include <Arduino.h>
+#include <map>
+#include <string>
+
+// Host stand-in for the ESP32 NVS Preferences API, kept in RAM.
+class Preferences {
+public:
+    bool begin(const char*, bool = false) { return true; }
+    void end() {}
+    bool isKey(const char* key) { return values.count(key) > 0; }
+    String getString(const char* key, const String& defaultValue = String()) { auto it = values.find(key); return it == values.end() ? defaultValue : String(it->second.c_str()); }
+    size_t putString(const char* key, const String& value) { values[key] = value.c_str(); return value.length(); }
+    bool remove(const char* key) { return values.erase(key) > 0; }
+    bool clear() { values.clear(); return true; }
+private:
+    std::map<std::string, std::string> values;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <Arduino.h>
+#include <IPAddress.h>
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+typedef enum { WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_CONNECTED = 3, WL_CONNECT_FAILED = 4, WL_DISCONNECTED = 6 } wl_status_t;
+
+// Loopback stand-in for the ESP32 WiFi driver. Connections succeed
+// immediately; scan results come from addScanResult(). Reading results after
+// scanDelete(), or starting a scan while the previous results were not
+// deleted, is counted in scanMisuse().
+class WiFiClass {
+public:
+    wifi_mode_t getMode() { return mode_; }
+    bool mode(wifi_mode_t m) { mode_ = m; return true; }
+    void persistent(bool) {}
+    void setAutoReconnect(bool) {}
+    bool setHostname(const char*) { return true; }
+    bool config(IPAddress ip, IPAddress gw, IPAddress mask, IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress()) { staticIp_ = ip; (void)gw; (void)mask; (void)dns1; (void)dns2; return true; }
+    wl_status_t begin(const char* ssid, const char* pw = nullptr, int32_t channel = 0, const uint8_t* bssid = nullptr, bool connect = true);
+    bool disconnect(bool wifioff = false, bool eraseap = false) { (void)wifioff; (void)eraseap; status_ = WL_DISCONNECTED; return true; }
+    wl_status_t status() { return status_; }
+    bool softAP(const char* ssid, const char* pw = nullptr) { (void)ssid; (void)pw; mode_ = WIFI_AP; return true; }
+    IPAddress softAPIP() { return IPAddress(127, 0, 0, 1); }
+    IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+    IPAddress gatewayIP() { return IPAddress(127, 0, 0, 1); }
+    IPAddress subnetMask() { return IPAddress(255, 0, 0, 0); }
+    IPAddress dnsIP(uint8_t = 0) { return IPAddress(127, 0, 0, 1); }
+    uint8_t* BSSID() { return bssid_; }
+    int32_t channel() { return 6; }
+    int16_t scanNetworks(bool async = false);
+    int16_t scanComplete() { return scanCount_; }
+    void scanDelete() { scanCount_ = -2; }
+    String SSID(uint8_t i);
+    String SSID() { return String("loopback"); }
+    int32_t RSSI(uint8_t i);
+
+    void addScanResult(const String& ssid, int32_t rssi);
+    uint32_t scanMisuse() const { return scanMisuse_; }
+
+private:
+    wifi_mode_t mode_ = WIFI_OFF;
+    wl_status_t status_ = WL_IDLE_STATUS;
+    IPAddress staticIp_;
+    uint8_t bssid_[6] = {0x02, 0, 0, 0, 0, 1};
+    int16_t scanCount_ = -2;
+    uint32_t scanMisuse_ = 0;
+};
+extern WiFiClass WiFi;
@@ -0,0 +1,6 @@
+#pragma once
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+inline esp_err_t esp_task_wdt_status(void*) { return ESP_FAIL; }
+inline esp_err_t esp_task_wdt_reset() { return ESP_OK; }
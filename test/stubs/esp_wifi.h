@@ -0,0 +1,5 @@
+#pragma once
+#include <esp_task_wdt.h>
+typedef enum { WIFI_IF_STA = 0, WIFI_IF_AP = 1 } wifi_interface_t;
+typedef enum { WIFI_BW_HT20 = 1, WIFI_BW_HT40 = 2 } wifi_bandwidth_t;
+inline esp_err_t esp_wifi_set_bandwidth(wifi_interface_t, wifi_bandwidth_t) { return ESP_OK; }
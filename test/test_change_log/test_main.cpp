@@ -0,0 +1,175 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "change_log.h"
+#include "chunk_filler.h"
+
+struct FakeParam {
+    String name;
+    uint32_t changed;
+    String value;
+
+    FakeParam(const String &name, uint32_t changed, const String &value) : name(name), changed(changed), value(value) {}
+
+    String jsonValue() {
+        if (value == "") return "";
+        return "\"" + json_encode(name) + "\":\"" + json_encode(value) + "\"";
+    }
+};
+
+typedef std::vector<std::vector<FakeParam *>> Endpoints;
+
+// Drives the generator through a ChunkFiller with a small buffer, so pieces
+// are split across chunks like on a busy connection.
+String body(ChunkFiller::Generator next, size_t chunk = 7) {
+    ChunkFiller filler(next);
+    String r;
+    uint8_t buf[64];
+    size_t n;
+    while ((n = filler.fill(buf, chunk)) > 0) {
+        for (size_t i = 0; i < n; i++) r += (char)buf[i];
+    }
+    return r;
+}
+
+void test_round_trip() {
+    FakeParam ssid("server", 3, "example.org"), port("port", 0, ""), debug("debug", 5, "");
+    Endpoints endpoints = {{&ssid, &port}, {&debug}};
+    ChangeLog log;
+    log.reset(0xc0ffee);
+    log.generation = 5;
+    String stored = log.serialize(endpoints);
+    TEST_ASSERT_EQUAL_STRING("00c0ffee 5\n3 server\n5 debug\n", stored.c_str());
+
+    ChangeLog loaded;
+    TEST_ASSERT_TRUE(loaded.parse(stored));
+    TEST_ASSERT_EQUAL(0xc0ffee, loaded.epoch);
+    TEST_ASSERT_EQUAL_STRING("00c0ffee", loaded.epochId().c_str());
+    TEST_ASSERT_EQUAL(5, loaded.generation);
+    TEST_ASSERT_EQUAL(3, loaded.stampOf("server"));
+    TEST_ASSERT_EQUAL(0, loaded.stampOf("port"));
+    TEST_ASSERT_EQUAL(5, loaded.stampOf("debug"));
+    TEST_ASSERT_EQUAL_STRING(stored.c_str(), loaded.serialize(endpoints).c_str());
+}
+
+void test_missing_key() {
+    ChangeLog log;
+    log.reset(7);
+    TEST_ASSERT_FALSE(log.parse(""));
+    TEST_ASSERT_EQUAL(0, log.epoch);
+    TEST_ASSERT_EQUAL(0, log.generation);
+
+    log.reset(0);
+    TEST_ASSERT_TRUE(log.epoch != 0);
+}
+
+void test_malformed_header() {
+    ChangeLog log;
+    TEST_ASSERT_FALSE(log.parse("5\n3 server\n"));            // no epoch
+    TEST_ASSERT_FALSE(log.parse("00c0ffee\n3 server\n"));     // no generation
+    TEST_ASSERT_FALSE(log.parse("c0ffee 5\n"));               // short epoch
+    TEST_ASSERT_FALSE(log.parse("00000000 5\n"));             // epoch 0
+    TEST_ASSERT_FALSE(log.parse("0xc0ffee 5\n"));
+    TEST_ASSERT_FALSE(log.parse("00c0ffee -5\n"));
+    TEST_ASSERT_FALSE(log.parse("00c0ffee 5x\n"));
+    TEST_ASSERT_FALSE(log.parse("00c0ffee 99999999999\n"));
+    TEST_ASSERT_FALSE(log.parse("00c0ffee  5\n"));
+    TEST_ASSERT_EQUAL(0, log.stampOf("server"));
+    TEST_ASSERT_TRUE(log.parse("00C0FFEE 5"));
+    TEST_ASSERT_EQUAL(5, log.generation);
+}
+
+void test_malformed_stamp_lines() {
+    ChangeLog log;
+    TEST_ASSERT_TRUE(log.parse("00c0ffee 5\n"
+                               "2 a\n"
+                               "\n"
+                               "b\n"
+                               "x c\n"
+                               "0 d\n"
+                               "6 e\n"
+                               "-1 f\n"
+                               "3 \n"
+                               "4 with space"));
+    TEST_ASSERT_EQUAL(2, log.stampOf("a"));
+    TEST_ASSERT_EQUAL(0, log.stampOf("b"));
+    TEST_ASSERT_EQUAL(0, log.stampOf("c"));
+    TEST_ASSERT_EQUAL(0, log.stampOf("d"));
+    TEST_ASSERT_EQUAL(0, log.stampOf("e"));  // newer than the generation
+    TEST_ASSERT_EQUAL(0, log.stampOf("f"));
+    TEST_ASSERT_EQUAL(4, log.stampOf("with space"));
+}
+
+struct Fixture {
+    FakeParam host{"host", 2, "example.org"};
+    FakeParam port{"port", 4, ""};
+    FakeParam user{"user", 0, "admin"};
+    FakeParam debug{"debug", 3, "on"};
+    FakeParam level{"level", 0, ""};
+    FakeParam untitled{"", 4, "x"};
+    std::vector<String> names{"main", "empty", "extras"};
+    Endpoints endpoints{{&host, &port, &user}, {}, {&untitled, &debug, &level}};
+    ChangeLog log;
+
+    Fixture() {
+        log.reset(0xabc);
+        log.generation = 4;
+    }
+
+    String changes(uint32_t since, bool reset) {
+        return body(ChangesJson<FakeParam>(names, endpoints, log, since, reset));
+    }
+};
+
+void test_changes_across_endpoints() {
+    Fixture f;
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"epoch\":\"00000abc\",\"generation\":4,\"changes\":{"
+        "\"main\":{\"host\":\"example.org\",\"port\":null},\"extras\":{\"debug\":\"on\"}}}",
+        f.changes(0, false).c_str());
+}
+
+void test_changes_since() {
+    Fixture f;
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"epoch\":\"00000abc\",\"generation\":4,\"changes\":{"
+        "\"main\":{\"port\":null},\"extras\":{\"debug\":\"on\"}}}",
+        f.changes(2, false).c_str());
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"epoch\":\"00000abc\",\"generation\":4,\"changes\":{\"main\":{\"port\":null}}}",
+        f.changes(3, false).c_str());
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"epoch\":\"00000abc\",\"generation\":4,\"changes\":{}}",
+        f.changes(4, false).c_str());
+}
+
+void test_changes_only_later_endpoint() {
+    Fixture f;
+    f.port.changed = 1;
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"epoch\":\"00000abc\",\"generation\":4,\"changes\":{\"extras\":{\"debug\":\"on\"}}}",
+        f.changes(2, false).c_str());
+}
+
+void test_changes_reset_lists_everything() {
+    Fixture f;
+    String expected =
+        "{\"epoch\":\"00000abc\",\"generation\":4,\"reset\":true,\"changes\":{"
+        "\"main\":{\"host\":\"example.org\",\"port\":null,\"user\":\"admin\"},"
+        "\"extras\":{\"debug\":\"on\",\"level\":null}}}";
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), f.changes(0, true).c_str());
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), f.changes(4, true).c_str());
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), body(ChangesJson<FakeParam>(f.names, f.endpoints, f.log, 0, true), 64).c_str());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_missing_key);
+    RUN_TEST(test_malformed_header);
+    RUN_TEST(test_malformed_stamp_lines);
+    RUN_TEST(test_changes_across_endpoints);
+    RUN_TEST(test_changes_since);
+    RUN_TEST(test_changes_only_later_endpoint);
+    RUN_TEST(test_changes_reset_lists_everything);
+    return UNITY_END();
+}
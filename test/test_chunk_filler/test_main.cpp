@@ -0,0 +1,61 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <string>
+#include <vector>
+#include "chunk_filler.h"
+
+ChunkFiller::Generator pieces(std::vector<const char *> list) {
+    size_t i = 0;
+    return [list, i](String &piece) mutable {
+        if (i == list.size()) return false;
+        piece = list[i++];
+        return true;
+    };
+}
+
+std::string drain(ChunkFiller &filler, size_t chunk, size_t *calls = nullptr) {
+    std::string body;
+    uint8_t buf[64];
+    size_t n;
+    while ((n = filler.fill(buf, chunk)) > 0) {
+        body.append(reinterpret_cast<char *>(buf), n);
+        if (calls) (*calls)++;
+    }
+    return body;
+}
+
+void test_small_chunks_split_pieces() {
+    ChunkFiller filler(pieces({"{\"values\":{", "\"a\":1", ",\"b\":\"xyz\"", "}}"}));
+    size_t calls = 0;
+    TEST_ASSERT_EQUAL_STRING("{\"values\":{\"a\":1,\"b\":\"xyz\"}}", drain(filler, 3, &calls).c_str());
+    TEST_ASSERT_EQUAL(10, calls);
+}
+
+void test_large_chunk_joins_pieces() {
+    ChunkFiller filler(pieces({"[", "\"x\"", ",\"y\"", "]"}));
+    size_t calls = 0;
+    TEST_ASSERT_EQUAL_STRING("[\"x\",\"y\"]", drain(filler, 64, &calls).c_str());
+    TEST_ASSERT_EQUAL(1, calls);
+}
+
+void test_empty_pieces_skipped() {
+    ChunkFiller filler(pieces({"", "a", "", "b", ""}));
+    TEST_ASSERT_EQUAL_STRING("ab", drain(filler, 1).c_str());
+}
+
+void test_done_stays_done() {
+    ChunkFiller filler(pieces({"a"}));
+    uint8_t buf[4];
+    TEST_ASSERT_EQUAL(1, filler.fill(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(0, filler.fill(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(0, filler.fill(buf, sizeof(buf)));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_small_chunks_split_pieces);
+    RUN_TEST(test_large_chunk_joins_pieces);
+    RUN_TEST(test_empty_pieces_skipped);
+    RUN_TEST(test_done_stays_done);
+    return UNITY_END();
+}
@@ -0,0 +1,116 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "connect_cache.h"
+
+ConnectCache sample(bool withIp) {
+    ConnectCache c;
+    const uint8_t bssid[6] = {0x00, 0x1a, 0x2b, 0x3c, 0x4d, 0xfe};
+    memcpy(c.bssid, bssid, 6);
+    c.channel = 11;
+    c.hasIp = withIp;
+    c.ip = IPAddress(192, 168, 1, 50);
+    c.gateway = IPAddress(192, 168, 1, 1);
+    c.subnet = IPAddress(255, 255, 255, 0);
+    c.dns = IPAddress(192, 168, 1, 2);
+    return c;
+}
+
+void test_format() {
+    TEST_ASSERT_EQUAL_STRING("00:1a:2b:3c:4d:fe 11\n\nhome", sample(false).serialize("home").c_str());
+    TEST_ASSERT_EQUAL_STRING("00:1a:2b:3c:4d:fe 11\n192.168.1.50 192.168.1.1 255.255.255.0 192.168.1.2\nhome",
+                             sample(true).serialize("home").c_str());
+}
+
+void test_round_trip() {
+    ConnectCache c;
+    TEST_ASSERT_TRUE(c.parse(sample(true).serialize("home"), "home", true));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(sample(true).bssid, c.bssid, 6);
+    TEST_ASSERT_EQUAL(11, c.channel);
+    TEST_ASSERT_TRUE(c.hasIp);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.50", c.ip.toString().c_str());
+    TEST_ASSERT_EQUAL_STRING("192.168.1.1", c.gateway.toString().c_str());
+    TEST_ASSERT_EQUAL_STRING("255.255.255.0", c.subnet.toString().c_str());
+    TEST_ASSERT_EQUAL_STRING("192.168.1.2", c.dns.toString().c_str());
+}
+
+void test_ip_ignored_without_cache_ip() {
+    ConnectCache c;
+    TEST_ASSERT_TRUE(c.parse(sample(true).serialize("home"), "home", false));
+    TEST_ASSERT_FALSE(c.hasIp);
+    TEST_ASSERT_EQUAL(11, c.channel);
+}
+
+void test_ssid_mismatch() {
+    ConnectCache c;
+    String content = sample(false).serialize("home");
+    TEST_ASSERT_FALSE(c.parse(content, "other", false));
+    TEST_ASSERT_FALSE(c.parse(content, "hom", false));
+    TEST_ASSERT_FALSE(c.parse(content, "home2", false));
+    TEST_ASSERT_FALSE(c.parse(content, "", false));
+    TEST_ASSERT_EQUAL(0, c.channel);
+}
+
+void test_ssid_with_spaces() {
+    ConnectCache c;
+    TEST_ASSERT_TRUE(c.parse(sample(true).serialize("My Home Net "), "My Home Net ", true));
+    TEST_ASSERT_TRUE(c.hasIp);
+    TEST_ASSERT_FALSE(c.parse(sample(true).serialize("My Home Net "), "My Home Net", true));
+}
+
+void test_channel_out_of_range() {
+    ConnectCache c;
+    TEST_ASSERT_FALSE(c.parse("00:1a:2b:3c:4d:fe 0\n\nhome", "home", false));
+    TEST_ASSERT_FALSE(c.parse("00:1a:2b:3c:4d:fe 15\n\nhome", "home", false));
+    TEST_ASSERT_FALSE(c.parse("00:1a:2b:3c:4d:fe -1\n\nhome", "home", false));
+    TEST_ASSERT_TRUE(c.parse("00:1a:2b:3c:4d:fe 14\n\nhome", "home", false));
+    TEST_ASSERT_TRUE(c.parse("00:1a:2b:3c:4d:fe 1\n\nhome", "home", false));
+
+    // 5 GHz
+    TEST_ASSERT_TRUE(c.parse("00:1a:2b:3c:4d:fe 36\n\nhome", "home", false));
+    TEST_ASSERT_EQUAL(36, c.channel);
+    TEST_ASSERT_TRUE(c.parse("00:1a:2b:3c:4d:fe 144\n\nhome", "home", false));
+    TEST_ASSERT_TRUE(c.parse("00:1a:2b:3c:4d:fe 149\n\nhome", "home", false));
+    TEST_ASSERT_TRUE(c.parse("00:1a:2b:3c:4d:fe 165\n\nhome", "home", false));
+    TEST_ASSERT_TRUE(c.parse("00:1a:2b:3c:4d:fe 177\n\nhome", "home", false));
+    TEST_ASSERT_FALSE(c.parse("00:1a:2b:3c:4d:fe 37\n\nhome", "home", false));
+    TEST_ASSERT_FALSE(c.parse("00:1a:2b:3c:4d:fe 148\n\nhome", "home", false));
+    TEST_ASSERT_FALSE(c.parse("00:1a:2b:3c:4d:fe 150\n\nhome", "home", false));
+    TEST_ASSERT_FALSE(c.parse("00:1a:2b:3c:4d:fe 181\n\nhome", "home", false));
+}
+
+void test_malformed() {
+    ConnectCache c;
+    TEST_ASSERT_FALSE(c.parse("", "", false));
+    TEST_ASSERT_FALSE(c.parse("00:1a:2b:3c:4d:fe 11\nhome", "home", false));
+    TEST_ASSERT_FALSE(c.parse("00:1a:2b 11\n\nhome", "home", false));
+    TEST_ASSERT_FALSE(c.parse("garbage\n\nhome", "home", false));
+}
+
+void test_missing_or_partial_ip_line() {
+    ConnectCache c;
+    // Empty IP line with cacheIp on: BSSID is used, DHCP runs.
+    TEST_ASSERT_TRUE(c.parse(sample(false).serialize("home"), "home", true));
+    TEST_ASSERT_FALSE(c.hasIp);
+
+    TEST_ASSERT_TRUE(c.parse("00:1a:2b:3c:4d:fe 11\n192.168.1.50 192.168.1.1\nhome", "home", true));
+    TEST_ASSERT_FALSE(c.hasIp);
+
+    TEST_ASSERT_TRUE(c.parse("00:1a:2b:3c:4d:fe 11\n192.168.1.50 192.168.1.1 255.255.255.0 dns\nhome", "home", true));
+    TEST_ASSERT_FALSE(c.hasIp);
+
+    TEST_ASSERT_TRUE(c.parse("00:1a:2b:3c:4d:fe 11\n192.168.1.50 192.168.1.1 255.255.255.0 192.168.1.256\nhome", "home", true));
+    TEST_ASSERT_FALSE(c.hasIp);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_format);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_ip_ignored_without_cache_ip);
+    RUN_TEST(test_ssid_mismatch);
+    RUN_TEST(test_ssid_with_spaces);
+    RUN_TEST(test_channel_out_of_range);
+    RUN_TEST(test_malformed);
+    RUN_TEST(test_missing_or_partial_ip_line);
+    return UNITY_END();
+}
@@ -0,0 +1,69 @@
+#include <unity.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "log_ring.h"
+
+void test_drains_in_order() {
+    HwsLogRing<4, 32> ring;
+    ring.write(HwsLogLevel::Info, "first %d", 1);
+    ring.write(HwsLogLevel::Warn, "second");
+    std::vector<std::string> lines;
+    size_t n = ring.drain([&](HwsLogLevel level, const char *line) {
+        lines.push_back(std::string(1, hwsLogLevelChar(level)) + line);
+    });
+    TEST_ASSERT_EQUAL(2, n);
+    TEST_ASSERT_EQUAL_STRING("Ifirst 1", lines[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("Wsecond", lines[1].c_str());
+    TEST_ASSERT_EQUAL(0, ring.drain([](HwsLogLevel, const char *) {}));
+}
+
+void test_full_ring_drops() {
+    HwsLogRing<2, 16> ring;
+    TEST_ASSERT_TRUE(ring.write(HwsLogLevel::Info, "a"));
+    TEST_ASSERT_TRUE(ring.write(HwsLogLevel::Info, "b"));
+    TEST_ASSERT_FALSE(ring.write(HwsLogLevel::Info, "c"));
+    TEST_ASSERT_EQUAL(1, ring.droppedCount());
+    TEST_ASSERT_EQUAL(2, ring.drain([](HwsLogLevel, const char *) {}));
+    TEST_ASSERT_TRUE(ring.write(HwsLogLevel::Info, "d"));
+}
+
+void test_long_lines_truncated() {
+    HwsLogRing<2, 8> ring;
+    ring.write(HwsLogLevel::Debug, "%s", "0123456789");
+    std::string got;
+    ring.drain([&](HwsLogLevel, const char *line) { got = line; });
+    TEST_ASSERT_EQUAL_STRING("0123456", got.c_str());
+}
+
+void test_concurrent_producers() {
+    HwsLogRing<64, 16> ring;
+    const int perThread = 1000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; t++)
+        producers.emplace_back([&ring, t] {
+            for (int i = 0; i < perThread; i++) ring.write(HwsLogLevel::Info, "%d", t);
+        });
+    size_t drained = 0;
+    bool wellFormed = true;
+    auto sink = [&](HwsLogLevel, const char *line) {
+        if (line[0] < '0' || line[0] > '3' || line[1]) wellFormed = false;
+        drained++;
+    };
+    while (drained + ring.droppedCount() < 4u * perThread) {
+        if (!ring.drain(sink)) std::this_thread::yield();
+    }
+    for (auto &p : producers) p.join();
+    ring.drain(sink);
+    TEST_ASSERT_TRUE(wellFormed);
+    TEST_ASSERT_EQUAL(4 * perThread, drained + ring.droppedCount());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_drains_in_order);
+    RUN_TEST(test_full_ring_drops);
+    RUN_TEST(test_long_lines_truncated);
+    RUN_TEST(test_concurrent_producers);
+    return UNITY_END();
+}
@@ -0,0 +1,95 @@
+#include <unity.h>
+#include "route_limiter.h"
+#include <thread>
+#include <vector>
+
+void test_concurrency_cap() {
+    RouteLimiter l(2, 0, 0);
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Admit);
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Admit);
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Busy);
+    l.release();
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Admit);
+    auto s = l.stats();
+    TEST_ASSERT_EQUAL(3, s.admitted);
+    TEST_ASSERT_EQUAL(1, s.busy);
+    TEST_ASSERT_EQUAL(2, s.inFlight);
+}
+
+void test_token_bucket() {
+    RouteLimiter l(0, 2, 3);  // 2 per second, burst of 3
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(l.acquire(1000) == RouteLimiter::Verdict::Admit);
+        l.release();
+    }
+    TEST_ASSERT_TRUE(l.acquire(1000) == RouteLimiter::Verdict::RateLimited);
+    TEST_ASSERT_EQUAL(1, l.retryAfter());
+    TEST_ASSERT_TRUE(l.acquire(1499) == RouteLimiter::Verdict::RateLimited);
+    TEST_ASSERT_TRUE(l.acquire(1500) == RouteLimiter::Verdict::Admit);
+    l.release();
+
+    // A long pause refills no more than the burst.
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(l.acquire(60000) == RouteLimiter::Verdict::Admit);
+        l.release();
+    }
+    TEST_ASSERT_TRUE(l.acquire(60000) == RouteLimiter::Verdict::RateLimited);
+    TEST_ASSERT_EQUAL(3, l.stats().rateLimited);
+}
+
+void test_retry_after_slow_rate() {
+    RouteLimiter l(1, 0.2f, 1);  // one every 5 seconds
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Admit);
+    l.release();
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::RateLimited);
+    TEST_ASSERT_EQUAL(5, l.retryAfter());
+}
+
+void test_release_without_acquire() {
+    RouteLimiter l(1, 0, 0);
+    l.release();
+    TEST_ASSERT_EQUAL(0, l.stats().inFlight);
+}
+
+void test_configure_applies_at_next_acquire() {
+    RouteLimiter l(1, 0, 0);
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Admit);
+    l.configure(2, 1, 1);
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Admit);
+    l.release();
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::RateLimited);
+
+    l.configure(0, 0, 0);
+    l.configure(3, 0, 0);  // only the last one counts
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Admit);
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Admit);
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Busy);
+}
+
+void test_configure_from_other_threads() {
+    RouteLimiter l(1, 0, 0);
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; t++)
+        writers.emplace_back([&l] {
+            for (int i = 0; i < 1000; i++) l.configure(1 + i % 3, 0, 0);
+        });
+    for (unsigned long now = 0; now < 2000; now++) {
+        if (l.acquire(now) == RouteLimiter::Verdict::Admit) l.release();
+    }
+    for (auto &w : writers) w.join();
+    l.configure(2, 0, 0);
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Admit);
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Admit);
+    TEST_ASSERT_TRUE(l.acquire(0) == RouteLimiter::Verdict::Busy);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_concurrency_cap);
+    RUN_TEST(test_token_bucket);
+    RUN_TEST(test_retry_after_slow_rate);
+    RUN_TEST(test_release_without_acquire);
+    RUN_TEST(test_configure_applies_at_next_acquire);
+    RUN_TEST(test_configure_from_other_threads);
+    return UNITY_END();
+}
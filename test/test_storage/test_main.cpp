@@ -0,0 +1,48 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <cstdlib>
+#include <unistd.h>
+#include "HeadlessWiFiSettingsStorage.h"
+#include "HostFileStorage.h"
+
+void check_backend(HeadlessWiFiSettingsStorage &s) {
+    TEST_ASSERT_FALSE(s.exists("missing"));
+    TEST_ASSERT_EQUAL_STRING("", s.read("missing").c_str());
+
+    TEST_ASSERT_TRUE(s.write("wifi-ssid", "home"));
+    TEST_ASSERT_TRUE(s.exists("wifi-ssid"));
+    TEST_ASSERT_EQUAL_STRING("home", s.read("wifi-ssid").c_str());
+
+    TEST_ASSERT_TRUE(s.write("wifi-ssid", "line\nfeed"));
+    TEST_ASSERT_EQUAL_STRING("line\nfeed", s.read("wifi-ssid").c_str());
+
+    TEST_ASSERT_TRUE(s.write("wifi-ssid", ""));
+    TEST_ASSERT_FALSE(s.exists("wifi-ssid"));
+    TEST_ASSERT_TRUE(s.write("wifi-ssid", ""));
+}
+
+void test_memory_storage() {
+    MemoryStorage s;
+    check_backend(s);
+}
+
+void test_host_file_storage() {
+    char dir[] = "/tmp/hws-storage-XXXXXX";
+    TEST_ASSERT_NOT_NULL(mkdtemp(dir));
+    HostFileStorage s(dir);
+    check_backend(s);
+
+    // Values survive a new instance, like they survive a reboot.
+    s.write("persisted", "yes");
+    HostFileStorage reopened(dir);
+    TEST_ASSERT_EQUAL_STRING("yes", reopened.read("persisted").c_str());
+    reopened.write("persisted", "");
+    rmdir(dir);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_memory_storage);
+    RUN_TEST(test_host_file_storage);
+    return UNITY_END();
+}